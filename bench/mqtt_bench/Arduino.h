@@ -0,0 +1,9 @@
+#ifndef BENCH_ARDUINO_H
+#define BENCH_ARDUINO_H
+
+// Host stand-in so the benchmark can use the firmware's constants.h and
+// pins.h unchanged
+#include <cstdint>
+#include <cstddef>
+
+#endif // BENCH_ARDUINO_H
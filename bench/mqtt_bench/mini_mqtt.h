@@ -0,0 +1,236 @@
+#ifndef MINI_MQTT_H
+#define MINI_MQTT_H
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Minimal MQTT 3.1.1 client over POSIX sockets for the host benchmark.
+// QoS0 only, like PubSubClient's publish path; just enough to talk to the
+// local mosquitto from docker-compose.yml.
+class MiniMqtt {
+public:
+    using MessageHandler = std::function<void(const std::string& topic, const char* payload, size_t length)>;
+
+private:
+    int fd;
+    std::vector<uint8_t> rxBuffer;
+    uint16_t nextPacketId;
+
+    static void appendString(std::vector<uint8_t>& out, const char* text) {
+        size_t length = strlen(text);
+        out.push_back((uint8_t)(length >> 8));
+        out.push_back((uint8_t)(length & 0xFF));
+        out.insert(out.end(), text, text + length);
+    }
+
+    bool sendPacket(uint8_t header, const std::vector<uint8_t>& body) {
+        std::vector<uint8_t> packet;
+        packet.reserve(body.size() + 5);
+        packet.push_back(header);
+
+        // Remaining length as MQTT varint
+        size_t remaining = body.size();
+        do {
+            uint8_t digit = remaining % 128;
+            remaining /= 128;
+            if (remaining > 0) {
+                digit |= 0x80;
+            }
+            packet.push_back(digit);
+        } while (remaining > 0);
+
+        packet.insert(packet.end(), body.begin(), body.end());
+
+        size_t sent = 0;
+        while (sent < packet.size()) {
+            ssize_t n = ::send(fd, packet.data() + sent, packet.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) {
+                return false;
+            }
+            sent += (size_t)n;
+        }
+        return true;
+    }
+
+    // Parses one complete packet from the front of rxBuffer.
+    // Returns bytes consumed, 0 if the packet is still incomplete.
+    size_t parsePacket(const MessageHandler& handler) {
+        if (rxBuffer.size() < 2) {
+            return 0;
+        }
+
+        size_t remaining = 0;
+        size_t multiplier = 1;
+        size_t pos = 1;
+        while (true) {
+            if (pos >= rxBuffer.size() || pos > 4) {
+                return 0;
+            }
+            uint8_t digit = rxBuffer[pos++];
+            remaining += (digit & 0x7F) * multiplier;
+            multiplier *= 128;
+            if ((digit & 0x80) == 0) {
+                break;
+            }
+        }
+
+        if (rxBuffer.size() < pos + remaining) {
+            return 0;
+        }
+
+        uint8_t type = rxBuffer[0] >> 4;
+        if (type == 3 && remaining >= 2) {
+            uint8_t qos = (rxBuffer[0] >> 1) & 0x03;
+            const uint8_t* body = rxBuffer.data() + pos;
+            size_t topicLength = ((size_t)body[0] << 8) | body[1];
+            size_t offset = 2 + topicLength + (qos > 0 ? 2 : 0);
+            if (offset <= remaining && handler) {
+                std::string topic((const char*)body + 2, topicLength);
+                handler(topic, (const char*)body + offset, remaining - offset);
+            }
+        }
+        return pos + remaining;
+    }
+
+public:
+    MiniMqtt() : fd(-1), nextPacketId(1) {}
+    ~MiniMqtt() { disconnect(); }
+
+    bool connect(const char* host, uint16_t port, const char* clientId, uint16_t keepAliveS = 60) {
+        addrinfo hints = {};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* result = nullptr;
+        std::string portStr = std::to_string(port);
+        if (getaddrinfo(host, portStr.c_str(), &hints, &result) != 0) {
+            return false;
+        }
+
+        for (addrinfo* ai = result; ai; ai = ai->ai_next) {
+            fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+            if (fd < 0) {
+                continue;
+            }
+            if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0) {
+                break;
+            }
+            ::close(fd);
+            fd = -1;
+        }
+        freeaddrinfo(result);
+        if (fd < 0) {
+            return false;
+        }
+
+        // Latency is what we measure - do not let Nagle batch small packets
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        std::vector<uint8_t> body;
+        appendString(body, "MQTT");
+        body.push_back(4);      // Protocol level 3.1.1
+        body.push_back(0x02);   // Clean session
+        body.push_back((uint8_t)(keepAliveS >> 8));
+        body.push_back((uint8_t)(keepAliveS & 0xFF));
+        appendString(body, clientId);
+        if (!sendPacket(0x10, body)) {
+            disconnect();
+            return false;
+        }
+
+        // Wait for CONNACK
+        uint8_t connack[4];
+        size_t received = 0;
+        while (received < sizeof(connack)) {
+            pollfd pfd = {fd, POLLIN, 0};
+            if (::poll(&pfd, 1, 5000) <= 0) {
+                disconnect();
+                return false;
+            }
+            ssize_t n = ::recv(fd, connack + received, sizeof(connack) - received, 0);
+            if (n <= 0) {
+                disconnect();
+                return false;
+            }
+            received += (size_t)n;
+        }
+        if (connack[0] != 0x20 || connack[3] != 0) {
+            disconnect();
+            return false;
+        }
+        return true;
+    }
+
+    bool subscribe(const char* topic) {
+        std::vector<uint8_t> body;
+        body.push_back((uint8_t)(nextPacketId >> 8));
+        body.push_back((uint8_t)(nextPacketId & 0xFF));
+        nextPacketId++;
+        appendString(body, topic);
+        body.push_back(0);  // QoS0
+        return sendPacket(0x82, body);
+    }
+
+    bool publish(const char* topic, const char* payload, bool retained = false) {
+        std::vector<uint8_t> body;
+        appendString(body, topic);
+        body.insert(body.end(), payload, payload + strlen(payload));
+        return sendPacket(retained ? 0x31 : 0x30, body);
+    }
+
+    bool ping() {
+        return sendPacket(0xC0, {});
+    }
+
+    // Waits up to timeoutMs for data and dispatches every complete PUBLISH.
+    // Returns false once the connection is gone.
+    bool poll(int timeoutMs, const MessageHandler& handler) {
+        if (fd < 0) {
+            return false;
+        }
+
+        pollfd pfd = {fd, POLLIN, 0};
+        int ready = ::poll(&pfd, 1, timeoutMs);
+        if (ready < 0) {
+            return false;
+        }
+        if (ready > 0) {
+            uint8_t chunk[4096];
+            ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) {
+                disconnect();
+                return false;
+            }
+            rxBuffer.insert(rxBuffer.end(), chunk, chunk + n);
+        }
+
+        size_t consumed;
+        while ((consumed = parsePacket(handler)) > 0) {
+            rxBuffer.erase(rxBuffer.begin(), rxBuffer.begin() + consumed);
+        }
+        return true;
+    }
+
+    void disconnect() {
+        if (fd >= 0) {
+            sendPacket(0xE0, {});
+            ::close(fd);
+            fd = -1;
+        }
+        rxBuffer.clear();
+    }
+
+    bool isConnected() const { return fd >= 0; }
+};
+
+#endif // MINI_MQTT_H
@@ -0,0 +1,643 @@
+// MQTT end-to-end latency and load benchmark against the local mosquitto.
+//
+// Runs an emulated controller and a load generator, each on its own broker
+// connection. The controller decodes, dispatches and acks commands with the
+// firmware's mqtt_command.h and publishes state with the same timing and
+// outbound queue as MqttHandler/main.cpp. The generator floods set,
+// set_position and JSON command topics and measures command -> ack and
+// command -> state publish latency, correlated on the ack id.
+//
+// Build from the repository root:
+//   g++ -std=c++17 -O2 -pthread -Ibench/mqtt_bench -Iinclude -Ilib/awning_core/src
+//       bench/mqtt_bench/mqtt_bench.cpp -o mqtt_bench
+//
+// Run with `docker compose up -d mosquitto`, then `./mqtt_bench --help`.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "constants.h"
+#include "awning_state_machine.h"
+#include "mqtt_command.h"
+#include "mqtt_outbound_queue.h"
+#include "mini_mqtt.h"
+
+struct BenchOptions {
+    std::string host = "localhost";
+    uint16_t port = 1883;
+    std::string baseTopic = "bench/awning";
+    double rate = 20.0;              // Commands per second
+    double durationS = 10.0;
+    double setRatio = 0.2;           // Share of OPEN/CLOSE/STOP on the set topic
+    double jsonRatio = 0.1;          // Share on the JSON command topic; the rest is set_position
+    unsigned long travelTimeMs = DEFAULT_TRAVEL_TIME_MS;
+    unsigned long publishIntervalMs = MQTT_PUBLISH_INTERVAL_MS;
+    double drainS = 6.0;             // Wait for late state publishes, > MQTT_STATE_REFRESH_MS
+    bool jsonState = true;           // false: per-topic state through the outbound queue
+    bool runDevice = true;           // false: load a real controller on the broker
+};
+
+static std::chrono::steady_clock::time_point benchStart;
+
+static unsigned long nowMs() {
+    return (unsigned long)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - benchStart).count();
+}
+
+static double nowUs() {
+    return (double)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - benchStart).count();
+}
+
+// =============================================================================
+// Emulated controller
+// =============================================================================
+
+// Records relay activations, which MotorController counts for the ack latency
+class BenchMotor : public IMotorHardware {
+public:
+    unsigned long activationCount = 0;
+    unsigned long lastActivationTime = 0;
+
+    void sendStartPulse(uint8_t) override {
+        activationCount++;
+        lastActivationTime = nowMs();
+    }
+    void sendStopPulse(uint8_t) override {}
+    void deactivateRelays() override {}
+};
+
+class BenchDevice {
+private:
+    const BenchOptions& options;
+    MiniMqtt client;
+    BenchMotor motor;
+    PositionTrackerCore tracker;
+    AwningStateMachine awning;
+    MqttOutboundQueue outbound;
+    unsigned long windThreshold;
+
+    std::string stateTopic;
+    std::string positionTopic;
+    std::string windPulsesTopic;
+    std::string windThresholdTopic;
+    std::string jsonStateTopic;
+    std::string ackTopic;
+
+    unsigned long lastPublish;
+    unsigned long lastRefresh;
+    bool wasMoving;
+
+    static bool isMotorCommand(const char* command) {
+        return strcmp(command, "OPEN") == 0 || strcmp(command, "CLOSE") == 0 || strcmp(command, "STOP") == 0;
+    }
+
+    void applyMotorCommand(const char* command) {
+        if (strcmp(command, "OPEN") == 0) {
+            awning.setTarget(MAX_POSITION);
+        } else if (strcmp(command, "CLOSE") == 0) {
+            awning.setTarget(MIN_POSITION);
+        } else if (strcmp(command, "STOP") == 0) {
+            awning.stopBoth();
+        }
+    }
+
+    static bool isValidThreshold(float threshold) {
+        return !std::isnan(threshold) && threshold >= MIN_WIND_PULSE_THRESHOLD &&
+               threshold <= MAX_WIND_PULSE_THRESHOLD;
+    }
+
+    bool sendMessage(const char* topic, const char* payload, bool retained) {
+        return client.publish(topic, payload, retained);
+    }
+
+    // Acks bypass the offline queue, as in MqttHandler::publishAck
+    void publishAck(MqttCommandTopic topic, const char* id, unsigned long receivedAt,
+                    const CommandResult& result, unsigned long activationsBefore) {
+        long latencyMs = -1;
+        if (motor.activationCount != activationsBefore) {
+            latencyMs = (long)(motor.lastActivationTime - receivedAt);
+        }
+        char payload[192];
+        formatMqttAck(payload, sizeof(payload), topic, id, result, latencyMs, nowMs() - receivedAt);
+        sendMessage(ackTopic.c_str(), payload, false);
+    }
+
+    // Same shape as MqttHandler::publishJsonState; host-only fields are 0
+    void publishJsonState() {
+        char payload[320];
+        snprintf(payload, sizeof(payload),
+                 "{\"state\":\"%s\",\"position\":%.1f,\"target\":%.1f,"
+                 "\"wind_pulses\":0,\"wind_threshold\":%lu,"
+                 "\"uptime\":%lu,\"rssi\":0,\"free_heap\":0,"
+                 "\"mqtt_queued\":%zu,\"mqtt_dropped\":%lu,\"broker\":0}",
+                 stateName(awning.getState(), awning.getCurrentPosition()),
+                 awning.getCurrentPosition(), awning.getTargetPosition(), windThreshold,
+                 nowMs(), outbound.size(), outbound.getDroppedCount());
+        sendMessage(jsonStateTopic.c_str(), payload, true);
+        statePublishes++;
+    }
+
+    // MqttHandler::publishState plus publishWindData
+    void publishTopicState() {
+        outbound.enqueueState(stateTopic.c_str(), stateName(awning.getState(), awning.getCurrentPosition()), true);
+        char value[16];
+        snprintf(value, sizeof(value), "%4.1f", awning.getCurrentPosition());
+        outbound.enqueueState(positionTopic.c_str(), value, true);
+        outbound.enqueueState(windPulsesTopic.c_str(), "0", true);
+        snprintf(value, sizeof(value), "%lu", windThreshold);
+        outbound.enqueueState(windThresholdTopic.c_str(), value, true);
+        statePublishes++;
+    }
+
+    void flushOutbound(unsigned long now) {
+        outbound.settle(now, MQTT_QUEUE_ACK_WINDOW_MS);
+        outbound.flush(now, [this](const char* topic, const char* payload, bool retained) {
+            return sendMessage(topic, payload, retained);
+        });
+    }
+
+public:
+    unsigned long received = 0;
+    unsigned long oversized = 0;
+    unsigned long rejected = 0;
+    unsigned long statePublishes = 0;
+
+    // Command callbacks, mirroring setupMqttCallbacks() in main.cpp
+    std::function<CommandResult(const char*)> onCommand;
+    std::function<CommandResult(float)> onSetPosition;
+    std::function<CommandResult(float)> onSetWindThreshold;
+    std::function<CommandResult(const JsonCommand&)> onJsonCommand;
+
+    explicit BenchDevice(const BenchOptions& opts)
+        : options(opts), awning(tracker, &motor), windThreshold(DEFAULT_WIND_PULSE_THRESHOLD),
+          lastPublish(0), lastRefresh(0), wasMoving(false) {
+        tracker.setTravelTime(options.travelTimeMs);
+        outbound.setRateLimit(MQTT_QUEUE_FLUSH_BURST, MQTT_QUEUE_FLUSH_INTERVAL_MS);
+        stateTopic = options.baseTopic + "/state";
+        positionTopic = options.baseTopic + "/position";
+        windPulsesTopic = options.baseTopic + "/wind_pulses";
+        windThresholdTopic = options.baseTopic + "/wind_threshold";
+        jsonStateTopic = options.baseTopic + "/json";
+        ackTopic = options.baseTopic + "/ack";
+
+        onCommand = [this](const char* command) -> CommandResult {
+            if (!isMotorCommand(command)) {
+                return {false, "unknown_command"};
+            }
+            applyMotorCommand(command);
+            return {true, nullptr};
+        };
+        onSetPosition = [this](float position) -> CommandResult {
+            if (std::isnan(position) || position < MIN_POSITION || position > MAX_POSITION) {
+                return {false, "out_of_range"};
+            }
+            awning.setTarget(position);
+            return {true, nullptr};
+        };
+        onSetWindThreshold = [this](float threshold) -> CommandResult {
+            if (!isValidThreshold(threshold)) {
+                return {false, "out_of_range"};
+            }
+            windThreshold = (unsigned long)threshold;
+            return {true, nullptr};
+        };
+        onJsonCommand = [this](const JsonCommand& cmd) -> CommandResult {
+            if (cmd.command && !isMotorCommand(cmd.command)) {
+                return {false, "unknown_command"};
+            }
+            if (cmd.command && cmd.hasPosition) {
+                return {false, "conflict"};
+            }
+            if (cmd.hasPosition && (std::isnan(cmd.position) || cmd.position < MIN_POSITION ||
+                                    cmd.position > MAX_POSITION)) {
+                return {false, "out_of_range"};
+            }
+            if (cmd.hasWindThreshold && !isValidThreshold(cmd.windThreshold)) {
+                return {false, "out_of_range"};
+            }
+            if (cmd.hasWindThreshold) {
+                windThreshold = (unsigned long)cmd.windThreshold;
+            }
+            if (cmd.command) {
+                applyMotorCommand(cmd.command);
+            } else if (cmd.hasPosition) {
+                awning.setTarget(cmd.position);
+            }
+            return {true, nullptr};
+        };
+    }
+
+    bool connect() {
+        if (!client.connect(options.host.c_str(), options.port, "bench_device")) {
+            return false;
+        }
+        for (int i = MQTT_COMMAND_SET; i < MQTT_COMMAND_TOPIC_COUNT; i++) {
+            std::string topic = options.baseTopic + MQTT_COMMAND_SUFFIXES[i];
+            if (!client.subscribe(topic.c_str())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static const char* stateName(AwningState state, float position) {
+        if (state == AWNING_EXTENDING) {
+            return "opening";
+        }
+        if (state == AWNING_RETRACTING) {
+            return "closing";
+        }
+        if (position >= 99.0f) {
+            return "open";
+        }
+        if (position <= 1.0f) {
+            return "closed";
+        }
+        return "stopped";
+    }
+
+    // MqttHandler::publishStatus
+    void publishStatus(unsigned long now, bool force) {
+        if (!force && now - lastPublish < options.publishIntervalMs) {
+            return;
+        }
+        lastPublish = now;
+        if (options.jsonState) {
+            publishJsonState();
+        } else {
+            publishTopicState();
+        }
+    }
+
+    // MqttHandler::staticCallback and processCommand
+    void handleMessage(const std::string& topic, const char* payload, size_t length) {
+        unsigned long receivedAt = nowMs();
+        received++;
+        if (topic.size() + length + 7 > MQTT_BUFFER_SIZE) {
+            oversized++;
+            return;
+        }
+
+        MqttCommandTopic commandTopic = mqttCommandForTopic(topic.c_str(), options.baseTopic.c_str());
+        if (commandTopic == MQTT_COMMAND_NONE) {
+            return;
+        }
+        unsigned long activationsBefore = motor.activationCount;
+
+        MqttCommand command;
+        CommandResult result = decodeMqttCommand(commandTopic, payload, length, (unsigned long)time(nullptr),
+                                                 MQTT_COMMAND_MAX_AGE_S, command);
+        if (result.accepted) {
+            result = dispatchMqttCommand(command, *this);
+        }
+        if (!result.accepted) {
+            rejected++;
+        }
+        publishAck(commandTopic, command.getId(), receivedAt, result, activationsBefore);
+    }
+
+    // One pass of the firmware main loop
+    bool loop(int pollTimeoutMs) {
+        bool alive = client.poll(pollTimeoutMs, [this](const std::string& topic, const char* payload, size_t length) {
+            handleMessage(topic, payload, length);
+        });
+
+        unsigned long now = nowMs();
+        awning.update(now);
+        bool isMoving = awning.isMoving();
+        if (wasMoving && !isMoving) {
+            publishStatus(now, true);
+        }
+        wasMoving = isMoving;
+        if (now - lastRefresh >= MQTT_STATE_REFRESH_MS) {
+            publishStatus(now, false);
+            lastRefresh = now;
+        }
+        flushOutbound(now);
+        return alive;
+    }
+
+    void ping() { client.ping(); }
+    unsigned long getDroppedCount() const { return outbound.getDroppedCount(); }
+};
+
+// =============================================================================
+// Load generator
+// =============================================================================
+
+struct LatencyStats {
+    std::vector<double> samples;
+
+    void add(double ms) { samples.push_back(ms); }
+
+    double percentile(double p) {
+        if (samples.empty()) {
+            return 0.0;
+        }
+        std::sort(samples.begin(), samples.end());
+        size_t index = (size_t)(p / 100.0 * (samples.size() - 1) + 0.5);
+        return samples[index];
+    }
+
+    void print(const char* label) {
+        if (samples.empty()) {
+            printf("%-22s n/a\n", label);
+            return;
+        }
+        printf("%-22s p50 %8.2f  p90 %8.2f  p99 %8.2f  max %8.2f  (n=%zu)\n", label,
+               percentile(50), percentile(90), percentile(99), percentile(100), samples.size());
+    }
+};
+
+class LoadGenerator {
+private:
+    const BenchOptions& options;
+    MiniMqtt client;
+    std::mt19937 rng;
+
+    std::string commandTopic;
+    std::string setPositionTopic;
+    std::string jsonCommandTopic;
+    std::string jsonStateTopic;
+    std::string positionTopic;
+    std::string ackTopic;
+
+    std::vector<double> sentAtUs;
+    std::vector<bool> acked;
+    std::vector<long> unreflected;  // Accepted, no state publish seen since the ack
+
+public:
+    LatencyStats ackLatency;
+    LatencyStats stateLatency;
+    std::map<std::string, unsigned long> ackRejected;  // By reason
+    unsigned long stateMessages = 0;
+
+    explicit LoadGenerator(const BenchOptions& opts)
+        : options(opts), rng(12345) {
+        commandTopic = options.baseTopic + MQTT_COMMAND_SUFFIXES[MQTT_COMMAND_SET];
+        setPositionTopic = options.baseTopic + MQTT_COMMAND_SUFFIXES[MQTT_COMMAND_SET_POSITION];
+        jsonCommandTopic = options.baseTopic + MQTT_COMMAND_SUFFIXES[MQTT_COMMAND_JSON];
+        jsonStateTopic = options.baseTopic + "/json";
+        positionTopic = options.baseTopic + "/position";
+        ackTopic = options.baseTopic + "/ack";
+    }
+
+    bool connect() {
+        if (!client.connect(options.host.c_str(), options.port, "bench_load")) {
+            return false;
+        }
+        return client.subscribe(jsonStateTopic.c_str()) && client.subscribe(positionTopic.c_str()) &&
+               client.subscribe(ackTopic.c_str());
+    }
+
+    void handleAck(const char* payload, size_t length, double now) {
+        long id = -1;
+        bool accepted = false;
+        std::string reason;
+        FlatJsonReader reader(payload, length);
+        reader.forEachMember([&](const char* key, size_t keyLength, const FlatJsonValue& value) {
+            if (FlatJsonReader::keyIs(key, keyLength, "id") && value.type == FLAT_JSON_NUMBER) {
+                id = strtol(value.text, nullptr, 10);
+            } else if (FlatJsonReader::keyIs(key, keyLength, "result")) {
+                accepted = std::string(value.text, value.length) == "\"accepted\"";
+            } else if (FlatJsonReader::keyIs(key, keyLength, "reason") && value.type == FLAT_JSON_STRING) {
+                reason.assign(value.text + 1, value.length - 2);
+            }
+        });
+        if (id < 0 || (size_t)id >= sentAtUs.size() || acked[id]) {
+            return;
+        }
+        acked[id] = true;
+        ackLatency.add((now - sentAtUs[id]) / 1000.0);
+        if (accepted) {
+            unreflected.push_back(id);
+        } else {
+            ackRejected[reason.empty() ? "unknown" : reason]++;
+        }
+    }
+
+    void handleMessage(const std::string& topic, const char* payload, size_t length) {
+        double now = nowUs();
+        if (topic == ackTopic) {
+            handleAck(payload, length, now);
+        } else if (topic == jsonStateTopic || topic == positionTopic) {
+            // The first state publish after an accepted ack reflects that command
+            stateMessages++;
+            for (long id : unreflected) {
+                stateLatency.add((now - sentAtUs[id]) / 1000.0);
+            }
+            unreflected.clear();
+        }
+    }
+
+    void sendCommand() {
+        long id = (long)sentAtUs.size();
+        unsigned long ts = (unsigned long)time(nullptr);
+        char payload[128];
+        const char* topic;
+
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        static const char* const commands[] = {"OPEN", "CLOSE", "STOP"};
+        double pick = unit(rng);
+        if (pick < options.setRatio) {
+            topic = commandTopic.c_str();
+            snprintf(payload, sizeof(payload), "{\"value\":\"%s\",\"ts\":%lu,\"id\":%ld}",
+                     commands[rng() % 3], ts, id);
+        } else if (pick < options.setRatio + options.jsonRatio) {
+            topic = jsonCommandTopic.c_str();
+            if (rng() % 2) {
+                snprintf(payload, sizeof(payload), "{\"command\":\"%s\",\"ts\":%lu,\"id\":%ld}",
+                         commands[rng() % 3], ts, id);
+            } else {
+                snprintf(payload, sizeof(payload), "{\"position\":%.1f,\"ts\":%lu,\"id\":%ld}",
+                         unit(rng) * 100.0, ts, id);
+            }
+        } else {
+            topic = setPositionTopic.c_str();
+            snprintf(payload, sizeof(payload), "{\"value\":%.1f,\"ts\":%lu,\"id\":%ld}",
+                     unit(rng) * 100.0, ts, id);
+        }
+
+        sentAtUs.push_back(nowUs());
+        acked.push_back(false);
+        client.publish(topic, payload, false);
+    }
+
+    bool poll(int timeoutMs) {
+        return client.poll(timeoutMs, [this](const std::string& topic, const char* payload, size_t length) {
+            handleMessage(topic, payload, length);
+        });
+    }
+
+    void ping() { client.ping(); }
+    size_t getSent() const { return sentAtUs.size(); }
+    size_t getAcked() const { return ackLatency.samples.size(); }
+    size_t getUnreflected() const { return unreflected.size(); }
+};
+
+// =============================================================================
+// Main
+// =============================================================================
+
+static void printUsage(const char* name) {
+    printf("Usage: %s [options]\n"
+           "  --host HOST          Broker host (localhost)\n"
+           "  --port PORT          Broker port (1883)\n"
+           "  --base TOPIC         Base topic (bench/awning)\n"
+           "  --rate N             Commands per second (20)\n"
+           "  --duration S         Load duration in seconds (10)\n"
+           "  --set-ratio R        Share of OPEN/CLOSE/STOP on the set topic (0.2)\n"
+           "  --json-ratio R       Share on the JSON command topic, rest set_position (0.1)\n"
+           "  --travel MS          Emulated travel time (%lu)\n"
+           "  --publish-interval MS  State publish interval (%lu)\n"
+           "  --topic-state        Per-topic state through the outbound queue, not JSON state\n"
+           "  --drain S            Wait for late replies after the run (6)\n"
+           "  --no-device          Only generate load, e.g. against a real controller\n",
+           name, DEFAULT_TRAVEL_TIME_MS, MQTT_PUBLISH_INTERVAL_MS);
+}
+
+static bool parseOptions(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--no-device") {
+            options.runDevice = false;
+        } else if (arg == "--topic-state") {
+            options.jsonState = false;
+        } else if (arg == "--host" && hasValue) {
+            options.host = argv[++i];
+        } else if (arg == "--port" && hasValue) {
+            options.port = (uint16_t)atoi(argv[++i]);
+        } else if (arg == "--base" && hasValue) {
+            options.baseTopic = argv[++i];
+        } else if (arg == "--rate" && hasValue) {
+            options.rate = atof(argv[++i]);
+        } else if (arg == "--duration" && hasValue) {
+            options.durationS = atof(argv[++i]);
+        } else if (arg == "--set-ratio" && hasValue) {
+            options.setRatio = atof(argv[++i]);
+        } else if (arg == "--json-ratio" && hasValue) {
+            options.jsonRatio = atof(argv[++i]);
+        } else if (arg == "--travel" && hasValue) {
+            options.travelTimeMs = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--publish-interval" && hasValue) {
+            options.publishIntervalMs = strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--drain" && hasValue) {
+            options.drainS = atof(argv[++i]);
+        } else {
+            return false;
+        }
+    }
+    return options.rate > 0.0 && options.durationS > 0.0;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    benchStart = std::chrono::steady_clock::now();
+    std::atomic<bool> running(true);
+
+    BenchDevice device(options);
+    std::thread deviceThread;
+    if (options.runDevice) {
+        if (!device.connect()) {
+            fprintf(stderr, "Device: cannot connect to %s:%u\n", options.host.c_str(), options.port);
+            return 1;
+        }
+        deviceThread = std::thread([&device, &running]() {
+            unsigned long lastPing = nowMs();
+            while (running.load() && device.loop(1)) {
+                if (nowMs() - lastPing > 30000) {
+                    device.ping();
+                    lastPing = nowMs();
+                }
+            }
+        });
+    }
+
+    LoadGenerator load(options);
+    if (!load.connect()) {
+        fprintf(stderr, "Load: cannot connect to %s:%u\n", options.host.c_str(), options.port);
+        running = false;
+        if (deviceThread.joinable()) {
+            deviceThread.join();
+        }
+        return 1;
+    }
+
+    // Let both subscriptions settle before the clock starts
+    for (int i = 0; i < 50; i++) {
+        load.poll(10);
+    }
+
+    double intervalUs = 1e6 / options.rate;
+    double loadStartUs = nowUs();
+    double loadEndUs = loadStartUs + options.durationS * 1e6;
+    double nextSendUs = loadStartUs;
+    unsigned long lastPing = nowMs();
+
+    while (nowUs() < loadEndUs) {
+        while (nowUs() >= nextSendUs && nextSendUs < loadEndUs) {
+            load.sendCommand();
+            nextSendUs += intervalUs;
+        }
+        if (!load.poll(1)) {
+            fprintf(stderr, "Load: connection lost\n");
+            break;
+        }
+        if (nowMs() - lastPing > 30000) {
+            load.ping();
+            lastPing = nowMs();
+        }
+    }
+
+    double drainEndUs = nowUs() + options.drainS * 1e6;
+    while (nowUs() < drainEndUs && load.poll(10)) {
+    }
+
+    running = false;
+    if (deviceThread.joinable()) {
+        deviceThread.join();
+    }
+
+    size_t sent = load.getSent();
+    double elapsedS = (nowUs() - loadStartUs) / 1e6 - options.drainS;
+    printf("Commands sent:         %zu (%.1f/s over %.1f s)\n", sent, sent / elapsedS, elapsedS);
+    unsigned long rejected = 0;
+    for (const auto& entry : load.ackRejected) {
+        rejected += entry.second;
+    }
+    printf("Acks received:         %zu (%zu missing, %lu rejected)\n",
+           load.getAcked(), sent - load.getAcked(), rejected);
+    for (const auto& entry : load.ackRejected) {
+        printf("  %-20s %lu\n", entry.first.c_str(), entry.second);
+    }
+    load.ackLatency.print("Command -> ack ms:");
+    load.stateLatency.print("Command -> state ms:");
+    printf("State publishes:       %lu (%zu accepted commands never reflected)\n",
+           load.stateMessages, load.getUnreflected());
+    if (options.runDevice) {
+        printf("Device:                received %lu, oversized %lu, rejected %lu, state publishes %lu, "
+               "queue dropped %lu\n",
+               device.received, device.oversized, device.rejected, device.statePublishes,
+               device.getDroppedCount());
+    }
+    return 0;
+}
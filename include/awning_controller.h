@@ -21,6 +21,7 @@ public:
     void setTarget(float target) { stateMachine.setTarget(target); }
     void stop(uint8_t relayPin) { stateMachine.stop(relayPin); }
     void stopBoth() { stateMachine.stopBoth(); }
+    void resumeMotion(AwningState direction, float target) { stateMachine.resumeMotion(direction, target); }
 
     // Update loop - call every iteration
     void update();
@@ -0,0 +1,25 @@
+#ifndef BOOT_STAGES_H
+#define BOOT_STAGES_H
+
+#include "boot_timeline.h"
+
+// Startup stages in the order they are reached. Everything up to
+// BOOT_POSITION is needed for safe operation; networking comes after.
+enum BootStage {
+    BOOT_RELAYS,      // Relay outputs driven off
+    BOOT_INPUTS,      // Buttons and wind sensor interrupt ready
+    BOOT_CONFIG,      // Configuration loaded
+    BOOT_POSITION,    // Position restored: safe to operate
+    BOOT_WIFI_START,  // WiFi connection started from loop()
+    BOOT_NETWORK,     // WiFi up, web interface, mDNS and UDP started
+    BOOT_MQTT,        // MQTT connected
+    BOOT_STAGE_COUNT
+};
+
+// Label values for /metrics and keys for /diag, in enum order
+const char* const BOOT_STAGE_NAMES[BOOT_STAGE_COUNT] = {"relays", "inputs", "config", "position",
+                                                        "wifi_start", "network", "mqtt"};
+
+extern BootTimeline<BOOT_STAGE_COUNT> bootTimeline;
+
+#endif // BOOT_STAGES_H
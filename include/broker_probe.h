@@ -0,0 +1,42 @@
+#ifndef BROKER_PROBE_H
+#define BROKER_PROBE_H
+
+#include <Arduino.h>
+#include <lwip/tcp.h>
+#include <lwip/dns.h>
+
+enum BrokerProbeResult {
+    PROBE_IDLE,
+    PROBE_PENDING,
+    PROBE_REACHABLE,
+    PROBE_UNREACHABLE
+};
+
+// Non-blocking TCP reachability check of a broker. The name lookup and the
+// connect run in lwIP callbacks; poll() collects the result from the main
+// loop, so a slow or dead broker never holds up motor or wind handling.
+class BrokerProbe {
+private:
+    enum State : uint8_t { IDLE, RESOLVING, CONNECTING, REACHABLE, UNREACHABLE };
+
+    State state;
+    struct tcp_pcb* pcb;
+    uint16_t port;
+    unsigned long startedAt;
+
+    void connectTo(const ip_addr_t* address);
+    void release();
+    static void onResolved(const char* name, const ip_addr_t* address, void* arg);
+    static err_t onConnected(void* arg, struct tcp_pcb* connected, err_t err);
+    static void onError(void* arg, err_t err);
+
+public:
+    BrokerProbe();
+    void start(const char* host, uint16_t port, unsigned long now);
+    // Returns the outcome once (then goes idle); gives up after timeoutMs
+    BrokerProbeResult poll(unsigned long now, unsigned long timeoutMs);
+    void cancel();
+    bool isRunning() const { return state != IDLE; }
+};
+
+#endif // BROKER_PROBE_H
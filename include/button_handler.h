@@ -19,6 +19,8 @@ private:
     unsigned long pressStartTime;
     bool longPressHandled;
     bool shortPressHandled;
+    unsigned long pressEdgeTime;  // Raw edge that started the current press
+    bool pressEdgePending;
     
     bool isDebounced() const;
     void updatePressTime();
@@ -28,6 +30,10 @@ public:
     ButtonHandler(uint8_t buttonPin);
     void begin();
     ButtonAction update();
+    
+    // Reports each press once, timed at its first edge rather than after
+    // debouncing or release
+    bool takePressEdge(unsigned long& edgeTime);
 };
 
 #endif // BUTTON_HANDLER_H
\ No newline at end of file
@@ -17,6 +17,12 @@ struct MQTTConfig {
     char password[64];
     char clientId[32];
     char baseTopic[64];
+    bool persistentSession;  // cleanSession=false with QoS1 command subscriptions
+    bool tlsEnabled;
+    char tlsFingerprint[60];  // SHA1 of the broker certificate, hex with ':' separators
+    char secondaryServer[64]; // Failover broker, empty if none
+    uint16_t secondaryPort;
+    bool jsonState;           // Single JSON state message instead of one topic per value
 };
 
 struct AwningConfig {
@@ -26,11 +32,20 @@ struct AwningConfig {
     float targetPosition;
 };
 
+// Access point of the last successful connection, for connecting without a scan
+struct WiFiFastConnectConfig {
+    uint8_t bssid[6];
+    uint8_t channel;           // 0 until a connection has been made
+    uint8_t reserved;
+    uint32_t credentialsHash;  // CRC of the SSID and password it was learned with
+};
+
 struct SystemConfig {
     uint32_t magic;
     WiFiConfig wifi;
     MQTTConfig mqtt;
     AwningConfig awning;
+    WiFiFastConnectConfig fastConnect;
     uint32_t checksum;
 };
 
@@ -41,6 +56,7 @@ private:
     
     uint32_t calculateChecksum(const SystemConfig& cfg) const;
     void setDefaults();
+    bool migrateFromV1();
     
 public:
     ConfigManager();
@@ -55,6 +71,8 @@ public:
     const char* getHostname() const { return config.wifi.hostname; }
     void setWiFiCredentials(const char* ssid, const char* password);
     void setHostname(const char* hostname);
+    const WiFiFastConnectConfig& getWiFiFastConnect() const { return config.fastConnect; }
+    void setWiFiFastConnect(const WiFiFastConnectConfig& fastConnect);
     
     // MQTT getters/setters
     bool isMQTTEnabled() const { return config.mqtt.enabled; }
@@ -64,7 +82,17 @@ public:
     const char* getMQTTPassword() const { return config.mqtt.password; }
     const char* getMQTTClientId() const { return config.mqtt.clientId; }
     const char* getMQTTBaseTopic() const { return config.mqtt.baseTopic; }
+    bool isMQTTPersistentSession() const { return config.mqtt.persistentSession; }
+    const char* getMQTTSecondaryServer() const { return config.mqtt.secondaryServer; }
+    uint16_t getMQTTSecondaryPort() const { return config.mqtt.secondaryPort; }
+    bool isMQTTTlsEnabled() const { return config.mqtt.tlsEnabled; }
+    bool isMQTTJsonState() const { return config.mqtt.jsonState; }
+    const char* getMQTTTlsFingerprint() const { return config.mqtt.tlsFingerprint; }
     void setMQTTEnabled(bool enabled);
+    void setMQTTPersistentSession(bool persistent);
+    void setMQTTTls(bool enabled, const char* fingerprint);
+    void setMQTTSecondaryBroker(const char* server, uint16_t port);
+    void setMQTTJsonState(bool enabled);
     void setMQTTConfig(const char* server, uint16_t port, const char* username, 
                        const char* password, const char* clientId, const char* baseTopic);
     
@@ -10,10 +10,50 @@ const unsigned long WIND_SENSOR_DEBOUNCE_MS = 10;
 const unsigned long POSITION_UPDATE_INTERVAL_MS = 100;
 const unsigned long MQTT_RECONNECT_INTERVAL_MS = 5000;
 const unsigned long MQTT_PUBLISH_INTERVAL_MS = 1000;
+const unsigned long MQTT_STATE_REFRESH_MS = 5000;  // Periodic state publish from the main loop, besides the one on stop
 const unsigned long MQTT_CONNECTION_TIMEOUT_MS = 10000;
 const unsigned long MQTT_MAX_FAILED_ATTEMPTS = 5;
 const unsigned long MQTT_BACKOFF_BASE_MS = 30000;
+const unsigned long MQTT_QUEUE_FLUSH_INTERVAL_MS = 100;
+const unsigned long MQTT_QUEUE_FLUSH_BURST = 4;
+const unsigned long MQTT_QUEUE_ACK_WINDOW_MS = 30000;  // > 1.5x keepalive, so a dead link is noticed first
+const unsigned long MQTT_DISCOVERY_JITTER_MS = 15000;  // Max random delay after a Home Assistant birth message
+const unsigned long MQTT_RETAINED_BIRTH_WINDOW_MS = 2000;  // Birth messages this soon after subscribing are retained copies
+const unsigned long MQTT_PRIMARY_PROBE_INTERVAL_MS = 300000;  // While on a secondary broker
+const unsigned long MQTT_PROBE_TIMEOUT_MS = 3000;  // Name lookup plus TCP connect, polled without blocking
+const unsigned long MQTT_COMMAND_MAX_AGE_S = 120;  // Timestamped commands older than this are rejected
+const unsigned long MIN_VALID_EPOCH = 1600000000;  // Wall clock below this is not yet synced via SNTP
+const size_t MQTT_BUFFER_SIZE = 1536;  // PubSubClient packet buffer; larger messages are dropped by the client
 const unsigned long MOTOR_PULSE_DELAY_MS = 500;
+const unsigned long CALIBRATION_PAUSE_MS = 3000;  // Between runs, so the button is released and the motor settled
+const unsigned long WEB_EVENTS_MOTION_INTERVAL_MS = 250;  // Status push cadence while the motor runs
+const unsigned long WEB_EVENTS_IDLE_INTERVAL_MS = 1000;
+const unsigned long WEB_EVENTS_KEEPALIVE_MS = 15000;  // Comment line so dead clients are noticed
+const uint8_t WEB_EVENTS_MAX_CLIENTS = 2;
+const size_t WEB_STATUS_JSON_SIZE = 192;  // Full /status document, per format
+const size_t WEB_METRICS_CHUNK_SIZE = 512;  // Stack buffer /metrics is streamed through
+const uint8_t WEB_MAX_TRANSFERS = 2;  // Pages sent from loop(); further requests are answered inline
+const unsigned long WEB_TRANSFER_TIMEOUT_MS = 10000;  // Drop a download whose client stopped reading
+
+// Boot Constants
+const unsigned long BOOT_SAFE_BUDGET_MS = 300;  // Reset to relays, inputs, config and position all up
+
+// OTA Constants
+const uint8_t OTA_WIND_RETRACT_PERCENT = 50;  // Wind above this share of the threshold retracts before an update
+const unsigned long OTA_RESTART_DELAY_MS = 1000;  // Lets the upload response reach the client
+const unsigned long OTA_RETRY_AFTER_S = 60;
+const char OTA_USERNAME[] = "admin";
+const char OTA_REALM[] = "awning-ota";
+
+// Set at build time from AWNING_OTA_PASSWORD (see platformio.ini); without
+// one, firmware uploads are refused
+#ifndef OTA_PASSWORD
+#define OTA_PASSWORD ""
+#endif
+
+// UDP Control Constants
+const uint16_t UDP_CONTROL_PORT = 4210;
+const uint8_t UDP_CONTROL_MAX_PACKETS_PER_LOOP = 4;
 
 // Position Constants
 const float POSITION_TOLERANCE = 1.0;
@@ -21,9 +61,15 @@ const float MIN_POSITION = 0.0;
 const float MAX_POSITION = 100.0;
 
 // EEPROM Constants
-const int EEPROM_SIZE = 512;
+const int EEPROM_SIZE = 1024;
 const uint32_t EEPROM_MAGIC_VALUE = 0xDEADBEEF;
 
+// RTC User Memory Constants (offsets in 4-byte blocks; the first 32 hold the OTA bootloader command)
+const uint32_t RTC_WIFI_BLOCK = 32;
+const uint32_t RTC_WIFI_MAGIC = 0x57494631;
+const uint32_t RTC_WARM_STATE_BLOCK = 48;
+const uint32_t RTC_WARM_STATE_MAGIC = 0x57524D31;
+
 // Default Settings
 const unsigned long DEFAULT_TRAVEL_TIME_MS = 15000;  // 15 seconds default travel time
 const unsigned long DEFAULT_WIND_PULSE_THRESHOLD = 100;  // 100 pulses per minute default threshold
@@ -0,0 +1,33 @@
+#ifndef HTML_STREAM_H
+#define HTML_STREAM_H
+
+#include <ESP8266WebServer.h>
+#include "config_manager.h"
+#include "html_template.h"
+
+// Size of the stack buffer each chunk is assembled in
+const size_t HTML_STREAM_CHUNK_SIZE = 256;
+
+// Sends a PROGMEM template as a chunked response, filling {{name}}
+// placeholders through resolve(name, scratch, scratchSize). Nothing is
+// allocated on the heap regardless of page size.
+template<typename Resolve>
+void streamHtmlTemplate(ESP8266WebServer& server, PGM_P page, Resolve resolve) {
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "text/html", "");
+    
+    HtmlTemplateWriter<HTML_STREAM_CHUNK_SIZE> writer;
+    auto sink = [&server](const char* data, size_t length) {
+        server.sendContent(data, length);
+    };
+    writer.render([page](size_t i) { return (char)pgm_read_byte(page + i); }, resolve, sink);
+    
+    // Zero-length chunk ends the response
+    server.sendContent("");
+}
+
+// Values of the configuration form fields, keyed by their input names
+const char* resolveConfigPlaceholder(const ConfigManager& config, const char* name, 
+                                     char* scratch, size_t scratchSize);
+
+#endif // HTML_STREAM_H
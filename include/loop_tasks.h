@@ -0,0 +1,21 @@
+#ifndef LOOP_TASKS_H
+#define LOOP_TASKS_H
+
+#include "loop_stats.h"
+
+// Parts of loop() that are timed separately
+enum LoopTask {
+    TASK_WIFI,
+    TASK_CONTROL,
+    TASK_WIND,
+    TASK_WEB,
+    TASK_MQTT,
+    LOOP_TASK_COUNT
+};
+
+// Label values for /metrics, in enum order
+const char* const LOOP_TASK_NAMES[LOOP_TASK_COUNT] = {"wifi", "control", "wind", "web", "mqtt"};
+
+extern LoopStats taskStats[LOOP_TASK_COUNT];
+
+#endif // LOOP_TASKS_H
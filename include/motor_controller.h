@@ -63,6 +63,8 @@ public:
     unsigned long getRunTime() const;
     bool isMoving() const;
     bool isBusy() const;
+    unsigned long getLastActivationTime() const { return core.getLastActivationTime(); }
+    unsigned long getActivationCount() const { return core.getActivationCount(); }
 
     // IMotorHardware interface implementation
     void sendStartPulse(uint8_t relayPin) override;
@@ -0,0 +1,11 @@
+#ifndef MQTT_CA_CERT_H
+#define MQTT_CA_CERT_H
+
+#include <Arduino.h>
+
+// Optional CA certificate (PEM) used to pin the MQTT broker when TLS is
+// enabled and no fingerprint is configured. Leave empty to disable.
+// For the local test broker, paste mosquitto/certs/ca.crt here.
+const char MQTT_CA_CERT[] PROGMEM = "";
+
+#endif // MQTT_CA_CERT_H
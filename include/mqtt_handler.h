@@ -7,20 +7,81 @@
 #include "position_tracker.h"
 #include "wind_sensor.h"
 #include "constants.h"
+#include "mqtt_outbound_queue.h"
+#include "broker_failover.h"
+#include "broker_probe.h"
+#include "mqtt_command.h"
+
+// Everything published per state cycle
+struct MqttStatus {
+    MotorState motorState;
+    float position;
+    float target;
+    unsigned long windPulses;
+    unsigned long windThreshold;
+};
 
 class MqttHandler {
 private:
     WiFiClient wifiClient;
+    BearSSL::WiFiClientSecure secureClient;
+    BearSSL::Session tlsSession;       // Reused across reconnects to skip the full handshake
+    BearSSL::X509List* trustAnchors;
+    WiFiClient* netClient;             // wifiClient or secureClient
     PubSubClient mqttClient;
     unsigned long lastReconnectAttempt;
     unsigned long lastPublish;
     unsigned long connectionStartTime;
     bool connectingInProgress;
     unsigned long failedAttempts;
+    bool wasConnected;
+    bool persistentSession;
+    bool tlsEnabled;
+    bool tlsConfigured;
+    bool tlsSessionValid;
+    int8_t tlsProbedBroker;            // Broker the fragment length probe ran against, -1 for none
+    char tlsFingerprint[60];
+    
+    // Last connect measurements
+    unsigned long lastConnectMs;
+    long lastConnectHeapUsed;
+    bool lastConnectResumed;
+    
+    // Totals since boot, for /metrics
+    unsigned long connectFailures;
+    unsigned long publishCount;
+    unsigned long publishFailures;
+    
+    // Pending outbound messages, survives disconnects
+    MqttOutboundQueue outbound;
+    
+    // Broker list: primary (server/port) and optional secondary
+    BrokerFailover failover;
+    BrokerProbe primaryProbe;          // Runs in the background while on the secondary
+    bool fastRetry;
+    unsigned long outageStart;
+    unsigned long lastFailoverMs;
+    
+    // Discovery is only resent on HA birth or when the payload changed
+    uint32_t coverDiscoveryHash;
+    uint32_t windDiscoveryHash;
+    bool discoveryPending;
+    unsigned long discoveryDueAt;
+    unsigned long subscribedAt;
+    
+    // Consolidated JSON state, latest-wins
+    bool jsonState;
+    bool jsonStatePending;
+    char jsonStateBuffer[320];
+    
+    // Relay activations are read from here to measure command latency
+    const MotorController* actuationSource;
     
     // Configuration
     char server[64];
     uint16_t port;
+    char secondaryServer[64];
+    uint16_t secondaryPort;
     char username[32];
     char password[64];
     char clientId[32];
@@ -37,11 +98,30 @@ private:
     char setWindThresholdTopic[128];
     char discoveryTopic[128];
     char windDiscoveryTopic[128];
+    static const char* HA_STATUS_TOPIC;
+    char eventTopic[128];
+    char jsonStateTopic[128];
+    char ackTopic[128];
+    char jsonCommandTopic[128];
     
     void buildTopics();
     bool reconnect();
     void subscribe();
-    void publishDiscovery();
+    void publishDiscovery(bool force);
+    bool publishDiscoveryPayload(const char* topic, const char* payload, uint32_t& publishedHash, bool force);
+    void scheduleDiscovery();
+    void flushOutbound();
+    bool sendMessage(const char* topic, const char* payload, bool retained);
+    void configureTls();
+    const char* activeServer() const { return failover.isOnPrimary() ? server : secondaryServer; }
+    uint16_t activePort() const { return failover.isOnPrimary() ? port : secondaryPort; }
+    void applyActiveBroker();
+    static unsigned long wallClock();
+    static const char* stateName(MotorState motorState, float position);
+    void publishAck(MqttCommandTopic topic, const char* id, unsigned long receivedAt,
+                    const CommandResult& result, unsigned long activationsBefore);
+    void publishJsonState(const MqttStatus& status);
+    void processCommand(MqttCommandTopic topic, const char* payload, size_t length);
     static void staticCallback(char* topic, byte* payload, unsigned int length);
     
 public:
@@ -49,16 +129,35 @@ public:
     void begin(const char* server, uint16_t port, const char* username, 
                const char* password, const char* clientId);
     void setBaseTopic(const char* topic);
+    void setPersistentSession(bool persistent) { persistentSession = persistent; }
+    void setTls(bool enabled, const char* fingerprint);
+    void setSecondaryBroker(const char* server, uint16_t port);
+    void setJsonState(bool enabled) { jsonState = enabled; }
+    void setActuationSource(const MotorController* motor) { actuationSource = motor; }
     void loop();
-    void publishState(MotorState motorState, float position);
+    void publishStatus(const MqttStatus& status, bool force = false);
+    void publishState(MotorState motorState, float position, bool force = false);
     void publishWindData(unsigned long pulses, unsigned long threshold);
+    void publishEvent(const char* event, float position, bool important);
     bool isConnected() { return mqttClient.connected(); }
+    bool isTlsEnabled() const { return tlsEnabled; }
+    uint8_t getActiveBrokerIndex() const { return failover.getActiveIndex(); }
+    unsigned long getLastFailoverMs() const { return lastFailoverMs; }
+    unsigned long getLastConnectMs() const { return lastConnectMs; }
+    long getLastConnectHeapUsed() const { return lastConnectHeapUsed; }
+    bool wasLastConnectResumed() const { return lastConnectResumed; }
+    size_t getQueuedCount() const { return outbound.size(); }
+    unsigned long getDroppedCount() const { return outbound.getDroppedCount(); }
+    unsigned long getConnectFailures() const { return connectFailures; }
+    unsigned long getPublishCount() const { return publishCount; }
+    unsigned long getPublishFailures() const { return publishFailures; }
     void processMessage(char* topic, char* message);
     
     // Callbacks for commands
-    std::function<void(const char*)> onCommand;
-    std::function<void(float)> onSetPosition;
-    std::function<void(float)> onSetWindThreshold;
+    std::function<CommandResult(const char*)> onCommand;
+    std::function<CommandResult(float)> onSetPosition;
+    std::function<CommandResult(float)> onSetWindThreshold;
+    std::function<CommandResult(const JsonCommand&)> onJsonCommand;
 };
 
 // Global instance for static callback
@@ -0,0 +1,32 @@
+#ifndef UDP_CONTROL_H
+#define UDP_CONTROL_H
+
+#include <WiFiUdp.h>
+#include "constants.h"
+#include "udp_protocol.h"
+
+// Compact binary status and position endpoint (see udp_protocol.h).
+// Commands go through the same queue as the web interface; every packet is
+// read into a fixed buffer and answered from it, so nothing is allocated.
+class UdpControl {
+private:
+    WiFiUDP udp;
+    UdpSequenceTracker sequences;
+    bool running;
+    unsigned long packetCount;
+    unsigned long droppedCount;
+
+    uint8_t handleRequest(const UdpRequest& request, uint32_t address, uint16_t port);
+    UdpStatus currentStatus();
+
+public:
+    UdpControl();
+    void begin(uint16_t port);
+    void stop();
+    void loop();
+
+    unsigned long getPacketCount() const { return packetCount; }
+    unsigned long getDroppedCount() const { return droppedCount; }
+};
+
+#endif // UDP_CONTROL_H
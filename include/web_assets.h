@@ -0,0 +1,181 @@
+// Generated by scripts/build_web_assets.py from web/ - do not edit
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <Arduino.h>
+
+// index.html: 13939 bytes source, 2668 bytes gzipped
+const uint8_t INDEX_HTML_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xc5, 0x5a, 0x6d, 0x6f, 0xdb, 0x38,
+    0x12, 0xfe, 0xee, 0x5f, 0xc1, 0xf5, 0xa2, 0x95, 0x8d, 0x8b, 0x65, 0x3b, 0x4e, 0x7a, 0xad, 0x63,
+    0x1b, 0xd7, 0x7a, 0x53, 0x60, 0x0f, 0xdd, 0x4d, 0xb0, 0x09, 0x6e, 0x71, 0xb8, 0xbb, 0x0f, 0xb4,
+    0x44, 0xd9, 0x6a, 0x24, 0x51, 0x10, 0xa9, 0x38, 0xd9, 0xa2, 0xff, 0xfd, 0x66, 0x48, 0x4a, 0xa2,
+    0x64, 0xc9, 0x4d, 0xb2, 0x57, 0x1c, 0x02, 0xd4, 0x32, 0x5f, 0x86, 0xcf, 0xbc, 0x3d, 0x33, 0x94,
+    0xbb, 0xf8, 0xe1, 0xa7, 0xab, 0xf5, 0xed, 0x3f, 0xaf, 0x2f, 0xc9, 0x4e, 0xc6, 0xd1, 0xaa, 0xb7,
+    0x28, 0x3e, 0x18, 0xf5, 0xe1, 0x43, 0x86, 0x32, 0x62, 0xab, 0xf7, 0xfb, 0x24, 0x4c, 0xb6, 0x64,
+    0xcd, 0x13, 0x99, 0xf1, 0x28, 0x62, 0xd9, 0x62, 0xac, 0x27, 0x7a, 0x8b, 0x98, 0x49, 0x4a, 0x12,
+    0x1a, 0xb3, 0x65, 0xff, 0x3e, 0x64, 0xfb, 0x94, 0x67, 0xb2, 0x4f, 0x3c, 0x58, 0xc8, 0x12, 0xb9,
+    0xec, 0xef, 0x43, 0x5f, 0xee, 0x96, 0x3e, 0xbb, 0x0f, 0x3d, 0x36, 0x52, 0x5f, 0x4e, 0x48, 0x98,
+    0x84, 0x32, 0xa4, 0xd1, 0x48, 0x78, 0x34, 0x62, 0xcb, 0x69, 0x1f, 0x84, 0x08, 0xf9, 0x88, 0xc2,
+    0x36, 0xdc, 0x7f, 0x24, 0x5f, 0x7a, 0x01, 0xec, 0x1e, 0x05, 0x34, 0x0e, 0xa3, 0xc7, 0x39, 0x79,
+    0x9f, 0xc1, 0xda, 0x13, 0x22, 0x68, 0x22, 0x46, 0x82, 0x65, 0x61, 0x70, 0xd1, 0x8b, 0x69, 0xb6,
+    0x0d, 0x93, 0x39, 0x39, 0x9d, 0xa4, 0x0f, 0x17, 0xbd, 0x0d, 0xf5, 0xee, 0xb6, 0x19, 0xcf, 0x13,
+    0x7f, 0xe4, 0xf1, 0x88, 0x67, 0x73, 0xf2, 0x63, 0x30, 0xc1, 0xbf, 0x8b, 0xde, 0xd7, 0x9e, 0x8b,
+    0x48, 0x68, 0x98, 0xb0, 0x0c, 0xe4, 0xc6, 0xf4, 0x41, 0x63, 0x98, 0x93, 0x37, 0x13, 0xb5, 0xb7,
+    0x90, 0x34, 0x21, 0x34, 0x97, 0xdc, 0x96, 0x35, 0x27, 0xfb, 0x5d, 0x28, 0xd9, 0x45, 0x2f, 0xa5,
+    0xbe, 0x0f, 0xba, 0x97, 0xa7, 0xf1, 0xcc, 0x67, 0xd9, 0x28, 0xa3, 0x7e, 0x98, 0x8b, 0x39, 0x99,
+    0x9a, 0xc1, 0x87, 0x91, 0xd8, 0x51, 0x9f, 0xef, 0x51, 0xd4, 0x69, 0xfa, 0xa0, 0xc6, 0x49, 0xb6,
+    0xdd, 0xd0, 0xc1, 0xe4, 0x44, 0xfd, 0xb9, 0xd3, 0x21, 0xe2, 0xd9, 0x4d, 0x01, 0x47, 0x01, 0x73,
+    0x36, 0x9b, 0x5d, 0xf4, 0x24, 0x7b, 0x90, 0x23, 0x1a, 0x85, 0x5b, 0x80, 0xe1, 0x81, 0xcd, 0x58,
+    0xa6, 0x70, 0x0b, 0x49, 0x65, 0x2e, 0x60, 0xb1, 0x0d, 0xe9, 0x47, 0xf6, 0x36, 0x38, 0x0b, 0x7c,
+    0x0b, 0xd4, 0xf4, 0xbc, 0x05, 0xd4, 0x79, 0xa5, 0xda, 0x68, 0xc3, 0xa5, 0xe4, 0x71, 0x81, 0xde,
+    0x18, 0x04, 0x7c, 0x88, 0xa2, 0xfd, 0x50, 0xa4, 0x11, 0x05, 0x1b, 0x07, 0x11, 0x83, 0xc9, 0x2d,
+    0x4d, 0x0b, 0x85, 0x5a, 0x37, 0x7f, 0xce, 0x85, 0x0c, 0x83, 0xc7, 0x91, 0x71, 0x6e, 0x0d, 0x6e,
+    0x29, 0x75, 0x93, 0xc3, 0x96, 0x04, 0x9d, 0x08, 0x32, 0x41, 0xdc, 0x85, 0x6d, 0xf5, 0xe9, 0xb9,
+    0x41, 0x51, 0xae, 0xaa, 0x14, 0x41, 0xab, 0xe9, 0x73, 0x94, 0xfb, 0x45, 0xf8, 0x07, 0x83, 0xd1,
+    0x37, 0x95, 0x7a, 0x73, 0x92, 0xf0, 0x84, 0xb5, 0x2b, 0xeb, 0xe5, 0x99, 0x40, 0x93, 0xa6, 0x3c,
+    0x2c, 0x21, 0x6d, 0x64, 0x32, 0xe2, 0x29, 0x4b, 0x9a, 0x36, 0x3c, 0x5b, 0xbf, 0xff, 0x78, 0x0e,
+    0xc1, 0x61, 0xbc, 0x60, 0xdc, 0x6c, 0x36, 0x78, 0x11, 0x17, 0xac, 0xb9, 0xe3, 0x74, 0xfa, 0xee,
+    0xcd, 0xc7, 0x59, 0xc7, 0x0e, 0x21, 0x79, 0xda, 0xdc, 0x10, 0x9c, 0x9d, 0xcd, 0x66, 0x6f, 0xba,
+    0x8e, 0xe0, 0x49, 0x10, 0x6e, 0x9b, 0x5b, 0x3e, 0x7e, 0x7c, 0xf7, 0x76, 0xd2, 0x86, 0x2a, 0xe5,
+    0x02, 0xd2, 0x85, 0xab, 0x7d, 0x68, 0x62, 0x48, 0x02, 0x0f, 0xbf, 0xab, 0x78, 0xae, 0xf2, 0x80,
+    0x4c, 0x0e, 0x43, 0xb5, 0x06, 0xe9, 0x1d, 0xfe, 0x1d, 0x58, 0xef, 0xad, 0x89, 0x8a, 0xf2, 0x14,
+    0x11, 0x85, 0x6a, 0x9e, 0xef, 0xcb, 0x03, 0xca, 0x30, 0xd0, 0xc1, 0x66, 0xaf, 0x0e, 0x93, 0x34,
+    0x97, 0x66, 0x71, 0x23, 0x9a, 0x54, 0x48, 0x8f, 0x40, 0x8b, 0x58, 0x54, 0x91, 0x62, 0x85, 0xd8,
+    0xb1, 0x68, 0x6a, 0xa0, 0x01, 0xe1, 0x45, 0x00, 0x4d, 0x26, 0xaf, 0x70, 0x85, 0x3a, 0xf7, 0x5f,
+    0xf2, 0x31, 0x05, 0xd6, 0xc9, 0x68, 0xb2, 0x65, 0xfd, 0xff, 0x34, 0x17, 0xed, 0x58, 0xb8, 0xdd,
+    0x81, 0xd8, 0x33, 0x75, 0xda, 0x68, 0xcf, 0x36, 0x77, 0x21, 0x24, 0x5a, 0x9a, 0x32, 0x0a, 0x3b,
+    0x3c, 0x56, 0x84, 0xd3, 0xe1, 0x88, 0x6d, 0x37, 0x09, 0x33, 0x22, 0xa5, 0x19, 0x60, 0x6b, 0x8d,
+    0xb2, 0x16, 0x20, 0xf3, 0x79, 0x71, 0x98, 0xb1, 0x25, 0xc8, 0xf0, 0xee, 0xba, 0xe0, 0xbd, 0x3d,
+    0xf0, 0x94, 0xef, 0xfb, 0x07, 0x6e, 0x3a, 0xd3, 0x86, 0x7f, 0xd2, 0x69, 0xbb, 0x3c, 0xde, 0xc0,
+    0x69, 0xcf, 0xd1, 0xd8, 0x20, 0x9b, 0x9d, 0xe2, 0x31, 0x05, 0x32, 0xfd, 0xad, 0x35, 0x75, 0x9a,
+    0x29, 0x88, 0x0a, 0x1d, 0x18, 0xc7, 0x04, 0x0f, 0xa4, 0xc7, 0x9c, 0x8c, 0xa6, 0xa7, 0xed, 0x3c,
+    0x79, 0xd6, 0xa4, 0xc9, 0xd3, 0x61, 0xb7, 0xa2, 0x31, 0xff, 0x63, 0xa4, 0xbe, 0x7d, 0x77, 0x93,
+    0x5a, 0x27, 0x19, 0x73, 0x7e, 0x17, 0x13, 0x35, 0x89, 0xed, 0x05, 0xd6, 0x49, 0x00, 0x1e, 0xcb,
+    0xec, 0xf0, 0x7f, 0xab, 0x02, 0xbe, 0xe4, 0x82, 0xf3, 0x8a, 0xf7, 0x81, 0x76, 0x0e, 0xd8, 0x43,
+    0xfb, 0xe7, 0xd4, 0xde, 0x63, 0x0f, 0x19, 0x35, 0xd4, 0xc8, 0x14, 0xd0, 0x08, 0x0e, 0x51, 0x66,
+    0x0c, 0x0a, 0x42, 0x03, 0x9e, 0xc5, 0x23, 0xd4, 0x3d, 0xb5, 0xe8, 0x68, 0x6a, 0xe8, 0xe8, 0x6b,
+    0x2f, 0xa2, 0x1b, 0x16, 0xd9, 0xd4, 0x10, 0x26, 0x11, 0xd4, 0xe2, 0xd1, 0x26, 0xe2, 0xde, 0x5d,
+    0x19, 0x76, 0xa6, 0x2a, 0x28, 0xda, 0xdf, 0x1b, 0xcb, 0x6e, 0x78, 0xa4, 0x4f, 0xd8, 0x87, 0x50,
+    0xd7, 0xc3, 0x24, 0xe0, 0x07, 0x1c, 0x1b, 0x04, 0x33, 0xaf, 0x56, 0x0a, 0x27, 0xc7, 0x4b, 0xa1,
+    0x0d, 0xec, 0x6f, 0x31, 0xf3, 0x43, 0x4a, 0x06, 0xcd, 0x8e, 0x60, 0x08, 0xa7, 0xd4, 0x5a, 0x86,
+    0x46, 0xa1, 0xb5, 0x25, 0x95, 0xe5, 0xdc, 0xae, 0x57, 0xee, 0x39, 0x8b, 0x9f, 0x5f, 0xe0, 0xba,
+    0x08, 0xad, 0x88, 0xb3, 0xa2, 0x6c, 0x3e, 0x27, 0xff, 0x8d, 0x5a, 0x9a, 0xfe, 0xea, 0x64, 0x58,
+    0xcf, 0xcc, 0x37, 0x2f, 0x4a, 0x84, 0x36, 0xb9, 0x4f, 0xab, 0x56, 0x68, 0xc9, 0x5a, 0xb5, 0x3a,
+    0x5e, 0x56, 0xb0, 0x9a, 0x8c, 0xf6, 0x19, 0x16, 0x0e, 0xfc, 0x17, 0x17, 0x7e, 0xed, 0x2d, 0xc6,
+    0xa6, 0x63, 0x5c, 0x8c, 0x4d, 0x9f, 0x8a, 0xad, 0x23, 0x7c, 0xf8, 0xe1, 0x3d, 0xf1, 0x22, 0x2a,
+    0xc4, 0xb2, 0x5f, 0xba, 0x11, 0x1b, 0xcc, 0xdd, 0xb4, 0xad, 0x87, 0x85, 0xd1, 0xda, 0x16, 0xdd,
+    0x74, 0xf5, 0x49, 0xe8, 0x97, 0xcf, 0x7a, 0xc1, 0x0a, 0x3a, 0xd4, 0x8c, 0x27, 0xdb, 0xd5, 0xb5,
+    0x81, 0x38, 0x47, 0x04, 0x6a, 0x84, 0x2c, 0xa0, 0x3e, 0x24, 0x6a, 0x4b, 0x81, 0xbf, 0xbf, 0x1a,
+    0x8d, 0x5e, 0xc1, 0x02, 0x18, 0x5f, 0x2d, 0xc6, 0xb8, 0xbd, 0x2e, 0xe4, 0x17, 0x2e, 0x81, 0x06,
+    0xda, 0x24, 0xc4, 0x38, 0x83, 0xdb, 0x8f, 0xec, 0xfe, 0x1d, 0x32, 0x82, 0x5c, 0xe7, 0x91, 0x60,
+    0xa2, 0x55, 0x06, 0x66, 0x8c, 0x9e, 0x46, 0x41, 0x64, 0x1c, 0x87, 0xc9, 0x11, 0x69, 0xb7, 0xe0,
+    0x15, 0x26, 0x5b, 0x05, 0x49, 0x35, 0xd5, 0xa6, 0x4c, 0x25, 0xc7, 0x36, 0x36, 0xf6, 0x7f, 0x68,
+    0x2f, 0x13, 0xfb, 0x66, 0xa6, 0x68, 0xc3, 0xfa, 0x84, 0x27, 0x5e, 0x14, 0x7a, 0x77, 0x60, 0x5a,
+    0x96, 0xf8, 0x6b, 0x1e, 0xc7, 0x34, 0xf1, 0x07, 0x0e, 0xce, 0x39, 0xc3, 0xfe, 0xea, 0xea, 0xfa,
+    0xf2, 0xd7, 0xc5, 0x58, 0xef, 0x6d, 0x15, 0x82, 0x8d, 0x56, 0x97, 0x10, 0x9c, 0x43, 0x21, 0x37,
+    0xb7, 0x57, 0xd7, 0x47, 0x85, 0xa8, 0xfe, 0xae, 0x4b, 0x8a, 0x9a, 0x44, 0x31, 0xeb, 0x4f, 0x57,
+    0x37, 0x97, 0x96, 0x9c, 0x43, 0x7d, 0xbb, 0xe2, 0x1c, 0xf5, 0xd7, 0xac, 0xa7, 0x02, 0x74, 0xd9,
+    0x2f, 0xa9, 0x4f, 0x73, 0x1e, 0x69, 0xb6, 0x54, 0x98, 0x38, 0xe4, 0x90, 0xfa, 0x40, 0x15, 0x26,
+    0x89, 0x15, 0x6d, 0x4a, 0x68, 0x07, 0x86, 0xaa, 0x67, 0xc3, 0xe3, 0x55, 0xf2, 0x10, 0x3b, 0x91,
+    0x6b, 0xc1, 0x79, 0xa3, 0x16, 0xf7, 0x09, 0x84, 0xc5, 0xb2, 0x3f, 0x81, 0x4f, 0xfa, 0xb0, 0xec,
+    0x43, 0x01, 0xed, 0x93, 0x7b, 0x1a, 0xe5, 0xb0, 0xe7, 0x1c, 0x1e, 0xdb, 0x4f, 0xe8, 0x1f, 0x37,
+    0x45, 0x99, 0xb5, 0x4d, 0x14, 0xa6, 0x46, 0xd5, 0x60, 0xfc, 0x03, 0x0f, 0x3b, 0x8e, 0x02, 0xef,
+    0x85, 0x18, 0x75, 0x45, 0xf4, 0x95, 0xfe, 0xb4, 0xbc, 0x27, 0x0b, 0x13, 0x0d, 0x86, 0xca, 0x64,
+    0x87, 0x4e, 0x6b, 0x8d, 0x55, 0xab, 0x12, 0x2a, 0x76, 0x98, 0xad, 0xd6, 0x6a, 0x30, 0xcf, 0x28,
+    0x8e, 0x01, 0x33, 0xcc, 0xea, 0x7b, 0xaa, 0x42, 0x57, 0x7a, 0x78, 0x75, 0x9b, 0xd1, 0x7b, 0x70,
+    0xf4, 0x6d, 0x18, 0x33, 0xcb, 0x41, 0x65, 0xfa, 0x40, 0xb5, 0xc7, 0xb6, 0x51, 0xaf, 0xc2, 0x45,
+    0xfd, 0xd5, 0x27, 0x4e, 0x91, 0xf2, 0x5c, 0xd7, 0x35, 0x2a, 0x91, 0x58, 0xb4, 0x22, 0x84, 0xe6,
+    0x79, 0xa3, 0xa1, 0xd4, 0x60, 0x9e, 0xad, 0xd6, 0xd5, 0x0c, 0x80, 0x3c, 0x83, 0xc1, 0x74, 0x35,
+    0x75, 0xc9, 0x65, 0x22, 0xf2, 0x8c, 0x11, 0xaa, 0x29, 0x2e, 0x14, 0x84, 0x4a, 0x32, 0x79, 0x45,
+    0x0a, 0x63, 0x2f, 0xc6, 0xa9, 0x5a, 0x79, 0xea, 0x92, 0x35, 0x5a, 0x8e, 0xdc, 0x40, 0x6e, 0xcb,
+    0x0b, 0x22, 0x77, 0xe5, 0x1e, 0xb8, 0x85, 0x42, 0x2a, 0xc0, 0x46, 0x20, 0x97, 0x8c, 0x61, 0x7f,
+    0x25, 0x05, 0xc4, 0x65, 0x46, 0x18, 0xf5, 0x76, 0x24, 0xcb, 0x4b, 0x19, 0x33, 0x97, 0x7c, 0xc8,
+    0x42, 0x16, 0x44, 0x8f, 0x24, 0xcd, 0x98, 0x80, 0x1d, 0x64, 0x4f, 0xa3, 0xa8, 0xb8, 0xf8, 0xa9,
+    0xe5, 0x12, 0xb4, 0x25, 0xa1, 0x04, 0x41, 0xf0, 0x8d, 0x09, 0x78, 0x14, 0x04, 0xa4, 0x37, 0xf0,
+    0x7c, 0xc3, 0xbc, 0xbf, 0xe5, 0x89, 0x20, 0x29, 0x54, 0x61, 0x3f, 0xcc, 0xb4, 0x0d, 0x2c, 0x2b,
+    0x77, 0x85, 0x97, 0x65, 0x39, 0xdc, 0x6f, 0x02, 0x6c, 0x6a, 0x02, 0xec, 0xbc, 0x0c, 0xaf, 0xa9,
+    0x15, 0xcb, 0x2d, 0x2c, 0xa1, 0x82, 0xa1, 0x2e, 0x91, 0x7d, 0x90, 0x36, 0x87, 0x49, 0xbe, 0xdd,
+    0x46, 0xcc, 0x72, 0x87, 0x0a, 0x40, 0x34, 0x2b, 0xa9, 0xf9, 0xa8, 0x0c, 0x47, 0xd4, 0xb6, 0x81,
+    0xf0, 0xc6, 0x94, 0x9b, 0x26, 0x55, 0xa8, 0x76, 0x90, 0xd8, 0x55, 0x5a, 0xd3, 0x44, 0xbd, 0xd5,
+    0x21, 0x6d, 0xed, 0x10, 0x29, 0x5a, 0x4a, 0xab, 0x59, 0x0b, 0x02, 0x46, 0xe9, 0x5f, 0x8b, 0xa9,
+    0x5a, 0x03, 0xac, 0xdf, 0xbd, 0x28, 0xe2, 0xb7, 0x50, 0x43, 0x9b, 0x06, 0xbe, 0xe5, 0x5b, 0x74,
+    0xaf, 0x8e, 0x55, 0xbd, 0x64, 0xb1, 0xc9, 0x56, 0xbd, 0xeb, 0x16, 0xa7, 0xef, 0x77, 0x70, 0xcd,
+    0xb6, 0x82, 0xa9, 0xcb, 0xef, 0x6e, 0x2d, 0xd8, 0x9b, 0xfe, 0x62, 0x22, 0x8f, 0xe4, 0x93, 0xad,
+    0xd1, 0x3f, 0x52, 0x8d, 0xca, 0xa6, 0xd1, 0xd2, 0x4f, 0x95, 0xcd, 0x1b, 0x1a, 0x30, 0xf9, 0x68,
+    0x55, 0x3b, 0xd3, 0x14, 0xec, 0x43, 0x50, 0x06, 0x5f, 0x01, 0xc5, 0x00, 0x05, 0x30, 0x41, 0x70,
+    0xeb, 0x37, 0x01, 0x61, 0x40, 0x52, 0xac, 0xa5, 0xc4, 0x03, 0x3b, 0x4b, 0xc8, 0x12, 0x8f, 0x31,
+    0xc8, 0x12, 0xb9, 0x03, 0x2b, 0xec, 0x80, 0xa8, 0xdb, 0x4e, 0x6f, 0x0b, 0x66, 0x75, 0xfa, 0x6d,
+    0xb1, 0xeb, 0x09, 0x81, 0x8c, 0x2a, 0x94, 0xeb, 0x0f, 0x79, 0xb2, 0x22, 0x4a, 0x24, 0xcd, 0x95,
+    0x06, 0x29, 0xb0, 0xd6, 0x1f, 0x8b, 0x67, 0x9b, 0x38, 0x7f, 0xb7, 0x0f, 0xe8, 0x64, 0xcf, 0x76,
+    0xb5, 0x0a, 0x1f, 0xb5, 0xbc, 0xbb, 0x22, 0x07, 0xd7, 0x8a, 0xfe, 0xea, 0x49, 0x90, 0x50, 0x61,
+    0xbe, 0x77, 0xa1, 0x4a, 0xaa, 0x68, 0x70, 0x01, 0x5a, 0xb0, 0x74, 0xc6, 0xe2, 0x51, 0x48, 0x16,
+    0x9b, 0xe5, 0x0e, 0xa0, 0x54, 0xdf, 0x49, 0x83, 0xae, 0x3b, 0x48, 0xdf, 0x7c, 0x08, 0x2f, 0x0b,
+    0x53, 0xb9, 0xea, 0xf9, 0xdc, 0xcb, 0x63, 0x80, 0xe9, 0x42, 0x5b, 0x73, 0x19, 0x31, 0x7c, 0xfc,
+    0xf0, 0xf8, 0x33, 0x14, 0xfe, 0x7a, 0x6d, 0x74, 0x86, 0x2e, 0x4f, 0xb4, 0x5f, 0x96, 0x24, 0xc8,
+    0x13, 0x4f, 0xa7, 0x37, 0xde, 0x63, 0xbe, 0x25, 0x40, 0x55, 0x35, 0xd8, 0xaf, 0x7c, 0x03, 0xbb,
+    0xe5, 0x2e, 0x14, 0xfa, 0x0b, 0xf4, 0xad, 0x17, 0x4f, 0xdf, 0xff, 0xd2, 0xf3, 0x4b, 0x05, 0x3a,
+    0x00, 0x14, 0xd2, 0x88, 0xdd, 0xf7, 0x50, 0x35, 0x84, 0xf2, 0x21, 0x39, 0xbc, 0xdd, 0xc0, 0x19,
+    0x9b, 0xa6, 0xc6, 0x39, 0xc1, 0xb6, 0x9d, 0xc9, 0x1d, 0x07, 0x86, 0x71, 0xae, 0xaf, 0x6e, 0x6e,
+    0x9d, 0x93, 0x1e, 0xf6, 0xdb, 0x2c, 0x03, 0xfe, 0xf8, 0xe2, 0xac, 0xf5, 0xab, 0x9b, 0xd1, 0x2d,
+    0x44, 0xaf, 0x03, 0x2b, 0x68, 0x9a, 0x82, 0x2f, 0x95, 0x4b, 0xc6, 0xd0, 0xb3, 0xef, 0xf7, 0x23,
+    0x15, 0x33, 0x79, 0x16, 0xb1, 0xc4, 0xe3, 0x3e, 0xf3, 0x9d, 0xaf, 0x27, 0xea, 0x1d, 0x2f, 0xae,
+    0x55, 0x87, 0x2e, 0x1d, 0xf2, 0x17, 0xa2, 0x1f, 0x7b, 0x5f, 0x87, 0x2e, 0x50, 0x48, 0x32, 0x80,
+    0x90, 0x4c, 0x79, 0x02, 0x29, 0xb7, 0x5c, 0xc1, 0xf1, 0x90, 0x80, 0x83, 0x1f, 0x8a, 0x21, 0x97,
+    0xdf, 0x0d, 0x31, 0xf7, 0xe0, 0x62, 0x90, 0xb0, 0x3d, 0xb9, 0xcc, 0x32, 0x9e, 0x0d, 0x1c, 0xa3,
+    0x07, 0x09, 0x68, 0x18, 0xc1, 0x19, 0x70, 0x45, 0xce, 0x53, 0x1f, 0x08, 0x5b, 0xd3, 0xeb, 0x00,
+    0xaf, 0xcc, 0x43, 0x17, 0x60, 0x81, 0x6a, 0x2c, 0xcb, 0x50, 0x2c, 0x85, 0xee, 0x5f, 0x0e, 0x1c,
+    0xb5, 0x1f, 0xb0, 0x00, 0x06, 0x98, 0x70, 0x63, 0x20, 0x36, 0xba, 0x65, 0x43, 0x75, 0xc7, 0xb6,
+    0x2c, 0x65, 0xf5, 0x18, 0xea, 0xe5, 0x6d, 0x22, 0x64, 0xc9, 0x68, 0x60, 0xe2, 0xe7, 0x05, 0xc5,
+    0xc5, 0xff, 0xc1, 0xc8, 0x05, 0x90, 0xd7, 0x9a, 0x32, 0x50, 0xdf, 0x62, 0xe8, 0xe5, 0x56, 0xc7,
+    0xfe, 0xb4, 0xb4, 0xc2, 0xf7, 0x31, 0x7d, 0x4b, 0x8d, 0xb5, 0x83, 0xb4, 0x28, 0xcc, 0xdf, 0xd3,
+    0x82, 0xd0, 0xf8, 0x08, 0x65, 0xb0, 0x4e, 0x2f, 0x37, 0x3a, 0x8e, 0xc2, 0xcf, 0xad, 0x86, 0x2d,
+    0x2d, 0x8a, 0xc4, 0x39, 0x30, 0x0b, 0x8c, 0xee, 0x4f, 0x35, 0x7c, 0x61, 0xaa, 0x36, 0x53, 0xff,
+    0x99, 0x30, 0xdf, 0xf1, 0xfd, 0xba, 0x59, 0x8c, 0x3b, 0xec, 0x3d, 0xec, 0x1d, 0x51, 0xed, 0xb3,
+    0x40, 0x3f, 0x59, 0x4b, 0x40, 0x4e, 0x5d, 0x37, 0x18, 0x70, 0x3d, 0x1e, 0xa7, 0x11, 0x93, 0xcc,
+    0x1f, 0x62, 0xb7, 0x99, 0x67, 0xc9, 0x85, 0x49, 0x2c, 0x7c, 0x3f, 0x04, 0x49, 0x35, 0xc0, 0x5f,
+    0x94, 0x4e, 0x08, 0x4c, 0xc3, 0x56, 0x7c, 0x06, 0xf0, 0x8e, 0xd6, 0xc1, 0x07, 0x0d, 0x68, 0xf2,
+    0x8b, 0xc0, 0x11, 0xe8, 0x9f, 0xc9, 0xbf, 0xf3, 0xc9, 0x64, 0x33, 0x35, 0x53, 0x42, 0xfa, 0x3e,
+    0xbb, 0xaf, 0x26, 0x07, 0x7a, 0x18, 0xdd, 0xa8, 0x86, 0xf0, 0x61, 0xe8, 0x14, 0x87, 0x41, 0xf7,
+    0xbe, 0x7c, 0x9a, 0x67, 0x15, 0x6a, 0x8c, 0x6f, 0x16, 0x29, 0xe7, 0x99, 0x98, 0x82, 0xed, 0x8e,
+    0xb9, 0x06, 0xa8, 0x9e, 0x17, 0x4f, 0x33, 0x1a, 0xca, 0xb2, 0xef, 0x37, 0x58, 0x5c, 0x9c, 0xed,
+    0xa1, 0x7e, 0xe0, 0x12, 0xd5, 0x6d, 0x43, 0xe0, 0x9a, 0xc5, 0xba, 0xfb, 0x1e, 0xe2, 0xca, 0x13,
+    0x25, 0x44, 0x2f, 0xfb, 0x4d, 0x37, 0xe2, 0xd5, 0x3a, 0xd3, 0x99, 0x6b, 0x1c, 0xaa, 0x08, 0xbb,
+    0xa6, 0x4f, 0x42, 0x24, 0xea, 0x8a, 0xe9, 0x60, 0x20, 0x34, 0x19, 0xac, 0x51, 0xec, 0x4b, 0x1a,
+    0x2b, 0xfb, 0x98, 0x63, 0x76, 0xa8, 0xb5, 0x22, 0x87, 0x3c, 0xa6, 0x9a, 0x2d, 0x53, 0x9f, 0xbf,
+    0x63, 0x26, 0x96, 0x50, 0x55, 0x3a, 0x56, 0x0d, 0xd8, 0x8b, 0x09, 0x4c, 0xb5, 0x64, 0x95, 0x01,
+    0x74, 0x36, 0x59, 0x4c, 0x66, 0xb2, 0xa7, 0x75, 0xd9, 0xff, 0x8a, 0xea, 0xb4, 0x17, 0xcc, 0x6f,
+    0x7d, 0x4b, 0xf2, 0x05, 0x4a, 0x34, 0x64, 0x05, 0xf4, 0xd6, 0xa2, 0xcc, 0x45, 0xe8, 0x4e, 0xa1,
+    0x0b, 0xa0, 0xd0, 0xde, 0x59, 0xe5, 0x1b, 0x2e, 0x96, 0x60, 0x53, 0x73, 0xb4, 0xc6, 0x81, 0x4e,
+    0xbd, 0xda, 0x7c, 0x86, 0x9b, 0x92, 0x0b, 0x4d, 0x16, 0xb4, 0x64, 0x03, 0x2d, 0xf6, 0xc4, 0x40,
+    0x86, 0xf3, 0xd0, 0x28, 0x7a, 0xd0, 0xad, 0xea, 0xd7, 0x72, 0x49, 0xe0, 0x06, 0xc1, 0x02, 0x08,
+    0x38, 0x2b, 0x19, 0xbf, 0x59, 0xd4, 0x20, 0x0e, 0xea, 0x79, 0xd0, 0x10, 0xec, 0x4a, 0xfe, 0x31,
+    0x7c, 0x60, 0xfe, 0x60, 0xaa, 0xa2, 0xfa, 0x95, 0x73, 0x44, 0xa6, 0x7e, 0xd1, 0xd4, 0x25, 0x51,
+    0xcf, 0x3e, 0x47, 0x9e, 0x7a, 0x8b, 0xd6, 0x25, 0x4e, 0x4d, 0x1e, 0xd9, 0x5c, 0xbd, 0x3e, 0xeb,
+    0x92, 0x50, 0xad, 0x50, 0x99, 0x8d, 0x4d, 0xf7, 0x31, 0x34, 0x07, 0xef, 0x01, 0x3a, 0x15, 0x2d,
+    0x57, 0x68, 0x57, 0x35, 0x12, 0x0f, 0x6f, 0x65, 0x95, 0xab, 0x9f, 0x97, 0xad, 0x75, 0xf0, 0xe5,
+    0xb4, 0x7a, 0xef, 0x8b, 0x27, 0x79, 0x55, 0xb4, 0x59, 0xe7, 0x90, 0xd7, 0xaf, 0xc9, 0x0f, 0xfa,
+    0xd1, 0xb5, 0x56, 0xe0, 0x70, 0x3d, 0x42, 0x11, 0x50, 0x47, 0x01, 0xc1, 0x23, 0x0e, 0xc2, 0xd9,
+    0x60, 0xb1, 0x64, 0xd6, 0x82, 0xd3, 0xab, 0x4b, 0xfe, 0x26, 0x41, 0xe3, 0xd5, 0xfc, 0xc0, 0xa8,
+    0xce, 0x1a, 0x7f, 0xe1, 0x8a, 0xec, 0xdb, 0xf8, 0x51, 0x2f, 0x35, 0xaf, 0xe5, 0x20, 0xb0, 0x9b,
+    0x60, 0xa1, 0x72, 0xa8, 0x9f, 0x89, 0x5f, 0x08, 0xed, 0xe0, 0x3d, 0xc1, 0x9f, 0x46, 0x86, 0x97,
+    0x64, 0x47, 0xbf, 0x1b, 0x2f, 0x49, 0xa2, 0xce, 0x4f, 0x56, 0x25, 0x17, 0x46, 0xcc, 0x73, 0xca,
+    0x78, 0xc5, 0x37, 0x30, 0x56, 0xa3, 0x39, 0xe4, 0x30, 0x0e, 0x68, 0x98, 0xe9, 0x0b, 0x35, 0x99,
+    0xd5, 0xe8, 0x74, 0x0e, 0x85, 0x01, 0xa6, 0x35, 0xe7, 0x45, 0xaa, 0x71, 0x8c, 0x54, 0xa0, 0x83,
+    0x00, 0x92, 0xe4, 0x51, 0x64, 0xdf, 0x4c, 0xd0, 0x36, 0xd7, 0x30, 0x0f, 0xde, 0x57, 0xa8, 0x31,
+    0x30, 0xca, 0xf5, 0x15, 0x43, 0x35, 0xd9, 0xd7, 0x16, 0x09, 0x15, 0xef, 0x67, 0xbc, 0x8d, 0x42,
+    0xec, 0x0f, 0xec, 0x75, 0x27, 0x70, 0x23, 0x9d, 0x4c, 0x86, 0x45, 0xd8, 0x9b, 0x2b, 0xe7, 0xe5,
+    0x3d, 0xd8, 0xfa, 0x86, 0xe7, 0x99, 0xc7, 0xaa, 0xca, 0xc8, 0x70, 0x10, 0x39, 0x59, 0x55, 0x8c,
+    0x6a, 0x05, 0x98, 0x4f, 0x4f, 0xa9, 0x66, 0x40, 0x3d, 0xb9, 0xd4, 0xf7, 0xd5, 0x8a, 0x4f, 0x21,
+    0xdc, 0x4d, 0x13, 0x96, 0xe1, 0xfb, 0x68, 0x65, 0x61, 0xd0, 0x5a, 0x1b, 0xd5, 0x62, 0xeb, 0xbf,
+    0xdf, 0x5c, 0xfd, 0xea, 0xa6, 0x34, 0x13, 0x6c, 0x00, 0x1e, 0xa4, 0x92, 0x0e, 0x87, 0x95, 0x24,
+    0xf0, 0x22, 0x5a, 0x11, 0x1b, 0xa0, 0x61, 0x55, 0xc8, 0xcc, 0x64, 0x06, 0x85, 0xf4, 0x11, 0xa5,
+    0x30, 0xc5, 0xda, 0x16, 0x28, 0x57, 0xbd, 0xb0, 0xfe, 0x69, 0xd8, 0x30, 0x9e, 0xba, 0xf2, 0x95,
+    0xb1, 0x7a, 0x30, 0x87, 0xbf, 0xa2, 0x98, 0x9b, 0x31, 0xdc, 0xa0, 0xf5, 0xef, 0x27, 0x63, 0xfd,
+    0xbf, 0x7f, 0xfe, 0x0b, 0xfc, 0xa7, 0x56, 0x79, 0x15, 0x24, 0x00, 0x00,
+};
+const size_t INDEX_HTML_GZ_LEN = 2668;
+const char INDEX_HTML_ETAG[] = "\"1f6dc384ce83606e\"";
+const char INDEX_HTML_TYPE[] = "text/html";
+
+#endif // WEB_ASSETS_H
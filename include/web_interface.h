@@ -4,25 +4,78 @@
 #include <ESP8266WebServer.h>
 #include <ESP8266WiFi.h>
 #include "config_manager.h"
+#include "constants.h"
+#include "html_stream.h"
+#include "status_delta.h"
+#include "status_cache.h"
+#include "control_command_queue.h"
+#include "connection_stats.h"
+#include "ota_session.h"
+
+// A response fed to its client from loop() in pieces that fit the TCP send
+// buffer, so a slow or large download never stalls the control loop
+struct WebTransfer {
+    WiFiClient client;
+    PGM_P data;            // Gzipped asset or page template
+    size_t length;         // Asset length; 0 for a template
+    size_t position;
+    bool isTemplate;
+    unsigned long lastProgress;
+    HtmlTemplateWriter<HTML_STREAM_CHUNK_SIZE> writer;
+};
 
 class WebInterface {
 private:
     ESP8266WebServer server;
     ConfigManager* configManager;
-    bool calibrationInProgress;
-    unsigned long calibrationStartTime;
     
+    // Server-Sent Events subscribers of /events
+    WiFiClient eventClients[WEB_EVENTS_MAX_CLIENTS];
+    StatusDeltaEncoder statusDelta;
+    StatusCache<WEB_STATUS_JSON_SIZE> statusCache;
+    unsigned long lastEventKeepalive;
+    
+    WebTransfer transfers[WEB_MAX_TRANSFERS];
+    ConnectionStats connectionStats;
+    
+    OtaSession ota;
+    bool restartPending;
+    unsigned long restartRequestedAt;
+    
+    void beginRequest(bool persistent);
     void handleRoot();
     void handleControl();
     void handleStatus();
     void handleCalibrate();
+    void handleCalibrationResult();
     void handleWindConfig();
     void handleSystemConfig();
     void handleSystemConfigSave();
     void handleFactoryReset();
     void handleNotFound();
+    void handleEvents();
+    void handleDiagnostics();
+    void handleMetrics();
+    void handleApiV2();
+    void handleUpdateUpload();
+    void handleUpdate();
+    void handleUpdateStatus();
+    bool isOtaAuthorized();
+    void restartWhenIdle();
+    void sendApiError(int code, const char* error, const char* field);
+    void sendGzipAsset(const char* contentType, const uint8_t* data, size_t length, const char* etag);
+    
+    StatusSnapshot getStatusSnapshot();
+    void pushStatusEvents();
+    bool sendEvent(WiFiClient& client, const char* data);
     
-    String getStatusJson();
+    WiFiClient detachClient();
+    WebTransfer* freeTransfer();
+    void serviceTransfers();
+    bool serviceTemplate(WebTransfer& transfer);
+    bool serviceAsset(WebTransfer& transfer);
+    int activeTransfers();
+    bool queueControl(ControlCommandType type, float position, const char* source);
     
 public:
     WebInterface(ConfigManager* config);
@@ -0,0 +1,380 @@
+#ifndef WEB_TEMPLATES_H
+#define WEB_TEMPLATES_H
+
+#include <Arduino.h>
+
+// Configuration pages, streamed by streamHtmlTemplate().
+// {{name}} placeholders are filled by resolveConfigPlaceholder().
+
+const char SYSTEM_CONFIG_TEMPLATE[] PROGMEM = R"rawliteral(
+<!DOCTYPE html>
+<html>
+<head>
+    <title>System Configuration</title>
+    <meta name="viewport" content="width=device-width, initial-scale=1">
+    <style>
+        body { font-family: Arial, sans-serif; margin: 20px; background: #f0f0f0; }
+        .container { max-width: 600px; margin: 0 auto; background: white; padding: 20px; border-radius: 10px; }
+        h1 { color: #333; text-align: center; }
+        .section { margin: 20px 0; padding: 15px; border: 1px solid #ddd; border-radius: 5px; }
+        .form-group { margin: 10px 0; }
+        label { display: inline-block; width: 150px; font-weight: bold; }
+        input[type="text"], input[type="password"], input[type="number"] { 
+            width: 200px; padding: 5px; border: 1px solid #ddd; border-radius: 4px; 
+        }
+        button { 
+            background: #FF9800; color: white; padding: 8px 16px; 
+            border: none; border-radius: 4px; cursor: pointer; margin: 5px; 
+        }
+        button:hover { background: #F57C00; }
+        .nav { text-align: center; margin-bottom: 20px; }
+        .nav a { margin: 0 10px; color: #2196F3; text-decoration: none; }
+    </style>
+</head>
+<body>
+    <div class="container">
+        <div class="nav">
+            <a href="/">Back to Control</a>
+        </div>
+        
+        <h1>System Configuration</h1>
+        
+        <form method="POST" action="/system-config">
+            <div class="section">
+                <h3>WiFi Settings</h3>
+                <div class="form-group">
+                    <label>WiFi SSID:</label>
+                    <input type="text" name="wifi_ssid" value="{{wifi_ssid}}">
+                </div>
+                <div class="form-group">
+                    <label>WiFi Password:</label>
+                    <input type="password" name="wifi_password" placeholder="Enter new password">
+                </div>
+                <div class="form-group">
+                    <label>Hostname:</label>
+                    <input type="text" name="hostname" value="{{hostname}}" maxlength="31">
+                </div>
+            </div>
+            
+            <div class="section">
+                <h3>MQTT Settings</h3>
+                <div class="form-group">
+                    <label>
+                        <input type="checkbox" name="mqtt_enabled" value="1" {{mqtt_enabled}}> 
+                        Enable MQTT Integration
+                    </label>
+                </div>
+                <div class="form-group">
+                    <label>MQTT Server:</label>
+                    <input type="text" name="mqtt_server" value="{{mqtt_server}}">
+                </div>
+                <div class="form-group">
+                    <label>MQTT Port:</label>
+                    <input type="number" name="mqtt_port" value="{{mqtt_port}}">
+                </div>
+                <div class="form-group">
+                    <label>Secondary Server:</label>
+                    <input type="text" name="mqtt_secondary_server" placeholder="Optional failover broker" value="{{mqtt_secondary_server}}">
+                </div>
+                <div class="form-group">
+                    <label>Secondary Port:</label>
+                    <input type="number" name="mqtt_secondary_port" value="{{mqtt_secondary_port}}">
+                </div>
+                <div class="form-group">
+                    <label>MQTT Username:</label>
+                    <input type="text" name="mqtt_username" value="{{mqtt_username}}">
+                </div>
+                <div class="form-group">
+                    <label>MQTT Password:</label>
+                    <input type="password" name="mqtt_password" placeholder="Enter new password">
+                </div>
+                <div class="form-group">
+                    <label>Client ID:</label>
+                    <input type="text" name="mqtt_client_id" value="{{mqtt_client_id}}">
+                </div>
+                <div class="form-group">
+                    <label>Base Topic:</label>
+                    <input type="text" name="mqtt_base_topic" value="{{mqtt_base_topic}}">
+                </div>
+                <div class="form-group">
+                    <label>
+                        <input type="checkbox" name="mqtt_persistent" value="1" {{mqtt_persistent}}> 
+                        Persistent session (commands survive reconnects)
+                    </label>
+                </div>
+                <div class="form-group">
+                    <label>
+                        <input type="checkbox" name="mqtt_tls" value="1" {{mqtt_tls}}> 
+                        Use TLS (usually port 8883)
+                    </label>
+                </div>
+                <div class="form-group">
+                    <label>
+                        <input type="checkbox" name="mqtt_json_state" value="1" {{mqtt_json_state}}> 
+                        Single JSON state topic
+                    </label>
+                </div>
+                <div class="form-group">
+                    <label>TLS Fingerprint:</label>
+                    <input type="text" name="mqtt_tls_fingerprint" maxlength="59" placeholder="AA:BB:... (SHA1)" value="{{mqtt_tls_fingerprint}}">
+                </div>
+            </div>
+            
+            <div style="text-align: center;">
+                <button type="submit">Save Configuration</button>
+            </div>
+        </form>
+        
+        <div style="text-align: center; margin-top: 30px; padding-top: 20px; border-top: 1px solid #ddd;">
+            <h3 style="color: #f44336;">Danger Zone</h3>
+            <p style="font-size: 14px; color: #666; margin: 10px 0;">
+                Factory reset will erase all WiFi, MQTT, and awning settings. The device will restart.
+            </p>
+            <button type="button" onclick="factoryReset()" 
+                    style="background: #f44336; color: white; padding: 10px 20px; border: none; border-radius: 4px; cursor: pointer;">
+                Factory Reset
+            </button>
+        </div>
+    </div>
+    
+    <script>
+        function factoryReset() {
+            if (confirm('WARNING: This will erase ALL settings and restart the device.\\n\\nAre you sure you want to continue?')) {
+                if (confirm('This action cannot be undone. Continue with factory reset?')) {
+                    fetch('/factory-reset', { method: 'POST' })
+                        .then(response => {
+                            if (response.ok) {
+                                alert('Factory reset initiated. Device will restart in a few seconds...');
+                                setTimeout(() => {
+                                    window.location.href = '/';
+                                }, 3000);
+                            } else {
+                                alert('Factory reset failed. Please try again.');
+                            }
+                        })
+                        .catch(error => {
+                            console.error('Reset failed:', error);
+                            alert('Factory reset failed. Please try again.');
+                        });
+                }
+            }
+        }
+    </script>
+</body>
+</html>
+)rawliteral";
+
+const char WIFI_SETUP_TEMPLATE[] PROGMEM = R"rawliteral(
+<!DOCTYPE html>
+<html>
+<head>
+    <title>Awning Controller Setup</title>
+    <meta name="viewport" content="width=device-width, initial-scale=1">
+    <style>
+        body { font-family: Arial, sans-serif; margin: 20px; background: #f0f0f0; }
+        .container { max-width: 500px; margin: 0 auto; background: white; padding: 20px; border-radius: 10px; }
+        h1 { color: #333; text-align: center; }
+        .form-group { margin: 15px 0; }
+        label { display: block; margin-bottom: 5px; font-weight: bold; }
+        input[type="text"], input[type="password"], input[type="number"] { 
+            width: 100%; padding: 8px; border: 1px solid #ddd; border-radius: 4px; box-sizing: border-box; 
+        }
+        button { 
+            background: #4CAF50; color: white; padding: 10px 20px; 
+            border: none; border-radius: 4px; cursor: pointer; width: 100%; font-size: 16px; 
+        }
+        button:hover { background: #45a049; }
+        .section { margin: 20px 0; padding: 15px; border: 1px solid #ddd; border-radius: 5px; }
+        .info { background: #e3f2fd; padding: 10px; border-radius: 4px; margin: 10px 0; }
+        .btn-scan { background: #2196F3; margin-bottom: 10px; }
+        .btn-scan:hover { background: #1976D2; }
+        .wifi-networks { max-height: 200px; overflow-y: auto; border: 1px solid #ddd; border-radius: 4px; margin: 10px 0; }
+        .wifi-network { 
+            padding: 10px; border-bottom: 1px solid #eee; cursor: pointer; display: flex; justify-content: space-between; align-items: center;
+        }
+        .wifi-network:hover { background: #f5f5f5; }
+        .wifi-network:last-child { border-bottom: none; }
+        .wifi-ssid { font-weight: bold; }
+        .wifi-signal { 
+            font-size: 12px; color: #666; display: flex; align-items: center; gap: 5px;
+        }
+        .signal-bars { font-size: 16px; }
+        .wifi-lock { color: #ff9800; }
+        .scanning { text-align: center; padding: 20px; color: #666; }
+    </style>
+</head>
+<body>
+    <div class="container">
+        <h1>Awning Controller Setup</h1>
+        
+        <div class="info">
+            Connect to your WiFi network and configure MQTT settings.
+        </div>
+        
+        <form method="POST" action="/save">
+            <div class="section">
+                <h3>WiFi Configuration</h3>
+                
+                <button type="button" class="btn-scan" onclick="scanWiFi()">Scan for Networks</button>
+                <div id="wifi-networks" class="wifi-networks" style="display: none;"></div>
+                
+                <div class="form-group">
+                    <label>WiFi Network (SSID):</label>
+                    <input type="text" id="wifi_ssid" name="wifi_ssid" value="{{wifi_ssid}}" required>
+                </div>
+                <div class="form-group">
+                    <label>WiFi Password:</label>
+                    <input type="password" name="wifi_password" value="">
+                </div>
+            </div>
+            
+            <div class="section">
+                <h3>MQTT Configuration</h3>
+                <div class="form-group">
+                    <label>
+                        <input type="checkbox" name="mqtt_enabled" value="1" {{mqtt_enabled}}> 
+                        Enable MQTT Integration
+                    </label>
+                </div>
+                <div class="form-group">
+                    <label>MQTT Server:</label>
+                    <input type="text" name="mqtt_server" value="{{mqtt_server}}">
+                </div>
+                <div class="form-group">
+                    <label>MQTT Port:</label>
+                    <input type="number" name="mqtt_port" value="{{mqtt_port}}" min="1" max="65535">
+                </div>
+                <div class="form-group">
+                    <label>MQTT Username (optional):</label>
+                    <input type="text" name="mqtt_username" value="{{mqtt_username}}">
+                </div>
+                <div class="form-group">
+                    <label>MQTT Password (optional):</label>
+                    <input type="password" name="mqtt_password" value="">
+                </div>
+                <div class="form-group">
+                    <label>Client ID:</label>
+                    <input type="text" name="mqtt_client_id" value="{{mqtt_client_id}}">
+                </div>
+                <div class="form-group">
+                    <label>Base Topic:</label>
+                    <input type="text" name="mqtt_base_topic" value="{{mqtt_base_topic}}">
+                </div>
+            </div>
+            
+            <button type="submit">Save Configuration</button>
+        </form>
+        
+        <div style="text-align: center; margin-top: 20px;">
+            <a href="/status">Check Status</a>
+            <br><br>
+            <button type="button" onclick="factoryReset()" style="background: #f44336; width: auto; padding: 8px 16px; font-size: 14px;">
+                Factory Reset
+            </button>
+        </div>
+    </div>
+    
+    <script>
+        function scanWiFi() {
+            const button = document.querySelector('.btn-scan');
+            const networksDiv = document.getElementById('wifi-networks');
+            
+            button.textContent = 'Scanning...';
+            button.disabled = true;
+            
+            networksDiv.innerHTML = '<div class="scanning">Scanning for WiFi networks...</div>';
+            networksDiv.style.display = 'block';
+            
+            fetchNetworks(15);
+        }
+        
+        // 202 means the controller started a scan; ask again until it is done
+        function fetchNetworks(attemptsLeft) {
+            const button = document.querySelector('.btn-scan');
+            const networksDiv = document.getElementById('wifi-networks');
+            
+            fetch('/scan')
+                .then(response => {
+                    if (response.status === 202) {
+                        if (attemptsLeft <= 1) {
+                            throw new Error('scan timed out');
+                        }
+                        setTimeout(() => fetchNetworks(attemptsLeft - 1), 1000);
+                        return null;
+                    }
+                    return response.json();
+                })
+                .then(networks => {
+                    if (!networks) {
+                        return;
+                    }
+                    displayNetworks(networks);
+                    button.textContent = 'Scan for Networks';
+                    button.disabled = false;
+                })
+                .catch(error => {
+                    console.error('Scan failed:', error);
+                    networksDiv.innerHTML = '<div class="scanning">Scan failed. Please try again.</div>';
+                    button.textContent = 'Scan for Networks';
+                    button.disabled = false;
+                });
+        }
+        
+        function displayNetworks(networks) {
+            const networksDiv = document.getElementById('wifi-networks');
+            
+            if (networks.length === 0) {
+                networksDiv.innerHTML = '<div class="scanning">No networks found</div>';
+                return;
+            }
+            
+            // Sort by signal strength (RSSI)
+            networks.sort((a, b) => b.rssi - a.rssi);
+            
+            let html = '';
+            networks.forEach(network => {
+                if (network.ssid && network.ssid.trim() !== '') {
+                    html += `
+                        <div class="wifi-network" onclick="selectNetwork('${escapeHtml(network.ssid)}')">
+                            <div class="wifi-ssid">${escapeHtml(network.ssid)}</div>
+                            <div class="wifi-signal">
+                                <span>${network.rssi} dBm</span>
+                            </div>
+                        </div>
+                    `;
+                }
+            });
+            
+            networksDiv.innerHTML = html || '<div class="scanning">No networks found</div>';
+        }
+        
+        function selectNetwork(ssid) {
+            document.getElementById('wifi_ssid').value = ssid;
+            document.getElementById('wifi-networks').style.display = 'none';
+        }
+        
+        
+        function escapeHtml(text) {
+            const div = document.createElement('div');
+            div.textContent = text;
+            return div.innerHTML;
+        }
+        
+        function factoryReset() {
+            if (confirm('Are you sure you want to reset all settings to defaults? This will erase WiFi, MQTT, and awning configuration. The device will restart.')) {
+                fetch('/reset', { method: 'POST' })
+                    .then(() => {
+                        alert('Factory reset initiated. Device will restart...');
+                    })
+                    .catch(error => {
+                        console.error('Reset failed:', error);
+                        alert('Reset failed. Please try again.');
+                    });
+            }
+        }
+    </script>
+</body>
+</html>
+)rawliteral";
+
+#endif // WEB_TEMPLATES_H
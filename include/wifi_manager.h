@@ -6,6 +6,8 @@
 #include <ESP8266WebServer.h>
 #include <DNSServer.h>
 #include "config_manager.h"
+#include "wifi_scan_cache.h"
+#include "rtc_record.h"
 
 enum AwningWiFiMode {
     AWNING_WIFI_CONNECTING,
@@ -14,6 +16,16 @@ enum AwningWiFiMode {
     AWNING_WIFI_FAILED
 };
 
+// Kept in RTC memory across resets: where the last connection went and the
+// address it got, so a restart can skip both the scan and DHCP
+struct WiFiRtcState {
+    WiFiFastConnectConfig accessPoint;
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+};
+
 class WiFiManager {
 private:
     ConfigManager* configManager;
@@ -26,10 +38,24 @@ private:
     bool apStarted;
     bool hasRetriedFromAP;
     
+    // Fast connect to a known access point, see connectToWiFi()
+    bool fastConnectAttempt;
+    unsigned long connectStartedAt;
+    unsigned long lastConnectDuration;
+    bool lastConnectWasFast;
+    
+    // Strongest networks of the last asynchronous scan, served by /scan
+    WifiScanCache<16> scanCache;
+    bool scanRunning;
+    unsigned long scanStartedAt;
+    
     static const unsigned long CONNECTION_TIMEOUT = 10000;
     static const unsigned long RETRY_INTERVAL = 60000;
     static const unsigned long STATUS_CHECK_INTERVAL = 5000;
     static const int MAX_CONNECTION_ATTEMPTS = 1;
+    static const unsigned long FAST_CONNECT_TIMEOUT = 3000;
+    static const unsigned long SCAN_CACHE_TTL = 30000;
+    static const unsigned long SCAN_TIMEOUT = 10000;
     static const char* AP_SSID;
     static const char* AP_PASSWORD;
     static const byte DNS_PORT = 53;
@@ -37,8 +63,14 @@ private:
     void startAP();
     void stopAP();
     bool connectToWiFi();
+    bool beginFastConnect(const char* ssid, const char* password);
+    void fallBackToFullConnect();
+    void rememberConnection();
+    uint32_t credentialsHash() const;
     void handleConfigPortal();
     void setupConfigServer();
+    void startScan();
+    void updateScan();
     
 public:
     WiFiManager(ConfigManager* config);
@@ -52,6 +84,8 @@ public:
     bool isInAPMode() const { return currentMode == AWNING_WIFI_AP_FALLBACK; }
     String getLocalIP() const;
     String getAPIP() const;
+    unsigned long getLastConnectDuration() const { return lastConnectDuration; }
+    bool wasFastConnect() const { return lastConnectWasFast; }
     
     // Configuration portal handlers
     void handleConfigRoot();
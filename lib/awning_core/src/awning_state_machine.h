@@ -119,6 +119,18 @@ public:
         state = AWNING_IDLE;
     }
 
+    // Takes over a movement the motor is already making, after a reset of
+    // this controller, without sending a pulse that would stop it
+    void resumeMotion(AwningState direction, float target) {
+        if (direction != AWNING_EXTENDING && direction != AWNING_RETRACTING) {
+            return;
+        }
+        lastMovementRelay = direction == AWNING_EXTENDING ? PIN_RELAY_EXTEND : PIN_RELAY_RETRACT;
+        targetPosition = clamp(target, MIN_POSITION, MAX_POSITION);
+        state = direction;
+        lastUpdateTime = 0;
+    }
+
     void update(unsigned long currentTimeMs) {
         // In IDLE: do nothing, wait for command
         if (state == AWNING_IDLE) {
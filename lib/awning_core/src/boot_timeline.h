@@ -0,0 +1,52 @@
+#ifndef BOOT_TIMELINE_H
+#define BOOT_TIMELINE_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Platform-independent record of when each of N startup stages was
+// reached, in microseconds since reset. Only the first mark of a stage
+// counts, so marks can sit in code that runs again later (reconnects).
+template<size_t N>
+class BootTimeline {
+private:
+    uint32_t reachedUs[N];
+    bool reached[N];
+
+public:
+    BootTimeline() {
+        for (size_t i = 0; i < N; i++) {
+            reachedUs[i] = 0;
+            reached[i] = false;
+        }
+    }
+
+    // Returns true if this was the first time the stage was reached
+    bool mark(size_t stage, uint32_t nowUs) {
+        if (stage >= N || reached[stage]) {
+            return false;
+        }
+        reachedUs[stage] = nowUs;
+        reached[stage] = true;
+        return true;
+    }
+
+    bool isReached(size_t stage) const { return stage < N && reached[stage]; }
+    uint32_t getUs(size_t stage) const { return isReached(stage) ? reachedUs[stage] : 0; }
+    unsigned long getMs(size_t stage) const { return getUs(stage) / 1000; }
+
+    // Time from the previous reached stage (or from reset) to this one
+    uint32_t getDurationUs(size_t stage) const {
+        if (!isReached(stage)) {
+            return 0;
+        }
+        for (size_t i = stage; i > 0; i--) {
+            if (reached[i - 1]) {
+                return reachedUs[stage] - reachedUs[i - 1];
+            }
+        }
+        return reachedUs[stage];
+    }
+};
+
+#endif // BOOT_TIMELINE_H
@@ -0,0 +1,70 @@
+#ifndef BROKER_FAILOVER_H
+#define BROKER_FAILOVER_H
+
+#include <cstdint>
+
+// Platform-independent selection of the MQTT broker from an ordered list.
+// A failed connect switches straight to the next broker; only when every
+// broker failed in a round does the caller fall back to its backoff.
+// While on a secondary broker, the primary is probed periodically.
+class BrokerFailover {
+public:
+    static constexpr uint8_t MAX_BROKERS = 2;
+
+private:
+    uint8_t brokerCount;
+    uint8_t activeIndex;
+    uint8_t failuresThisRound;
+    unsigned long lastProbeTime;
+
+public:
+    BrokerFailover()
+        : brokerCount(1)
+        , activeIndex(0)
+        , failuresThisRound(0)
+        , lastProbeTime(0) {}
+
+    void setBrokerCount(uint8_t count) {
+        brokerCount = count == 0 ? 1 : (count > MAX_BROKERS ? MAX_BROKERS : count);
+        activeIndex = 0;
+        failuresThisRound = 0;
+    }
+
+    // Returns true if the next broker should be tried immediately,
+    // false if the whole list failed and the caller should back off
+    bool onConnectFailed() {
+        failuresThisRound++;
+        activeIndex = (activeIndex + 1) % brokerCount;
+        if (failuresThisRound < brokerCount) {
+            return true;
+        }
+        // Round complete - start again from the primary after backing off
+        failuresThisRound = 0;
+        activeIndex = 0;
+        return false;
+    }
+
+    void onConnected(unsigned long now) {
+        failuresThisRound = 0;
+        lastProbeTime = now;
+    }
+
+    bool shouldProbePrimary(unsigned long now, unsigned long intervalMs) {
+        if (isOnPrimary() || now - lastProbeTime < intervalMs) {
+            return false;
+        }
+        lastProbeTime = now;
+        return true;
+    }
+
+    void switchToPrimary() {
+        activeIndex = 0;
+        failuresThisRound = 0;
+    }
+
+    uint8_t getActiveIndex() const { return activeIndex; }
+    uint8_t getBrokerCount() const { return brokerCount; }
+    bool isOnPrimary() const { return activeIndex == 0; }
+};
+
+#endif // BROKER_FAILOVER_H
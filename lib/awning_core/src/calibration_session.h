@@ -0,0 +1,160 @@
+#ifndef CALIBRATION_SESSION_H
+#define CALIBRATION_SESSION_H
+
+#include <cmath>
+#include <cstdint>
+
+// Running mean and variance of measured travel times (Welford's method)
+class TravelTimeStats {
+private:
+    unsigned int count;
+    double mean;
+    double m2;
+
+public:
+    TravelTimeStats() : count(0), mean(0.0), m2(0.0) {}
+
+    void add(unsigned long durationMs) {
+        count++;
+        double delta = durationMs - mean;
+        mean += delta / count;
+        m2 += delta * (durationMs - mean);
+    }
+
+    void reset() {
+        count = 0;
+        mean = 0.0;
+        m2 = 0.0;
+    }
+
+    unsigned int getCount() const { return count; }
+    double getMean() const { return mean; }
+    // Sample variance; 0 until there are two runs
+    double getVariance() const { return count > 1 ? m2 / (count - 1) : 0.0; }
+    double getStdDev() const { return std::sqrt(getVariance()); }
+};
+
+enum CalibrationDirection {
+    CALIBRATE_EXTEND,
+    CALIBRATE_RETRACT
+};
+
+enum CalibrationPhase {
+    CALIBRATION_IDLE,
+    CALIBRATION_STARTING,  // Next run is due to be started
+    CALIBRATION_RUNNING,   // Motor runs, waiting for the stop event
+    CALIBRATION_PAUSED     // Between runs, letting the motor settle
+};
+
+// Platform-independent travel time calibration over several runs,
+// alternating extend and retract. Each run is timed from the moment the
+// start pulse switched the relay on to the stop event (a button edge or an
+// end stop), both taken on the device, so no network latency is included.
+class CalibrationSession {
+public:
+    static constexpr uint8_t MAX_RUNS_PER_DIRECTION = 5;
+
+private:
+    CalibrationPhase phase;
+    CalibrationDirection direction;
+    uint8_t runsPerDirection;
+    unsigned long runStartTime;
+    unsigned long pausedAt;
+    unsigned long minRunMs;
+    bool completed;
+    TravelTimeStats extendStats;
+    TravelTimeStats retractStats;
+
+    TravelTimeStats& statsFor(CalibrationDirection dir) {
+        return dir == CALIBRATE_EXTEND ? extendStats : retractStats;
+    }
+
+public:
+    CalibrationSession()
+        : phase(CALIBRATION_IDLE)
+        , direction(CALIBRATE_EXTEND)
+        , runsPerDirection(1)
+        , runStartTime(0)
+        , pausedAt(0)
+        , minRunMs(0)
+        , completed(false) {}
+
+    // Starts with an extend run. Stop events sooner than minRunMs after the
+    // start are ignored, so a stray press does not end a run.
+    void begin(uint8_t runs, unsigned long minimumRunMs) {
+        if (runs < 1) {
+            runs = 1;
+        }
+        if (runs > MAX_RUNS_PER_DIRECTION) {
+            runs = MAX_RUNS_PER_DIRECTION;
+        }
+        runsPerDirection = runs;
+        minRunMs = minimumRunMs;
+        direction = CALIBRATE_EXTEND;
+        phase = CALIBRATION_STARTING;
+        completed = false;
+        extendStats.reset();
+        retractStats.reset();
+    }
+
+    void cancel() {
+        phase = CALIBRATION_IDLE;
+    }
+
+    // True when the firmware should start the motor for the next run
+    bool isStartDue(unsigned long now, unsigned long pauseMs) const {
+        return phase == CALIBRATION_STARTING || (phase == CALIBRATION_PAUSED && now - pausedAt >= pauseMs);
+    }
+
+    // Relay switch-on time of the start pulse for the current run
+    void onMotorStarted(unsigned long activationTime) {
+        if (phase == CALIBRATION_STARTING || phase == CALIBRATION_PAUSED) {
+            runStartTime = activationTime;
+            phase = CALIBRATION_RUNNING;
+        }
+    }
+
+    // The awning reached its end. Returns true if the run was recorded.
+    bool onStopEvent(unsigned long eventTime) {
+        if (phase != CALIBRATION_RUNNING) {
+            return false;
+        }
+        unsigned long duration = eventTime - runStartTime;
+        if (duration < minRunMs) {
+            return false;
+        }
+
+        statsFor(direction).add(duration);
+        if (extendStats.getCount() >= runsPerDirection && retractStats.getCount() >= runsPerDirection) {
+            phase = CALIBRATION_IDLE;
+            completed = true;
+            return true;
+        }
+
+        direction = direction == CALIBRATE_EXTEND ? CALIBRATE_RETRACT : CALIBRATE_EXTEND;
+        phase = CALIBRATION_PAUSED;
+        pausedAt = eventTime;
+        return true;
+    }
+
+    bool isActive() const { return phase != CALIBRATION_IDLE; }
+    bool isCompleted() const { return completed; }
+    CalibrationPhase getPhase() const { return phase; }
+    CalibrationDirection getDirection() const { return direction; }
+    uint8_t getRunsPerDirection() const { return runsPerDirection; }
+    unsigned int getCompletedRuns() const { return extendStats.getCount() + retractStats.getCount(); }
+    const TravelTimeStats& getExtendStats() const { return extendStats; }
+    const TravelTimeStats& getRetractStats() const { return retractStats; }
+
+    // The position tracker uses one travel time for both directions
+    unsigned long getTravelTime() const {
+        unsigned int total = getCompletedRuns();
+        if (total == 0) {
+            return 0;
+        }
+        double sum = extendStats.getMean() * extendStats.getCount() + retractStats.getMean() * retractStats.getCount();
+        return static_cast<unsigned long>(sum / total + 0.5);
+    }
+};
+
+#endif // CALIBRATION_SESSION_H
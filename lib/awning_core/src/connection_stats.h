@@ -0,0 +1,61 @@
+#ifndef CONNECTION_STATS_H
+#define CONNECTION_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Platform-independent count of HTTP requests and of those that arrived on
+// an already used connection. A connection is identified by the client's
+// address and port; the last few are remembered because responses handed
+// to the main loop interleave with other requests.
+class ConnectionStats {
+public:
+    static constexpr size_t TRACKED_CONNECTIONS = 4;
+
+private:
+    struct Endpoint {
+        uint32_t address;
+        uint16_t port;
+    };
+
+    Endpoint recent[TRACKED_CONNECTIONS];
+    size_t recentCount;
+    size_t nextSlot;
+    unsigned long requests;
+    unsigned long reused;
+
+public:
+    ConnectionStats()
+        : recentCount(0)
+        , nextSlot(0)
+        , requests(0)
+        , reused(0) {}
+
+    // Returns true if the request came over a connection seen before
+    bool record(uint32_t address, uint16_t port) {
+        requests++;
+        for (size_t i = 0; i < recentCount; i++) {
+            if (recent[i].address == address && recent[i].port == port) {
+                reused++;
+                return true;
+            }
+        }
+        recent[nextSlot] = {address, port};
+        nextSlot = (nextSlot + 1) % TRACKED_CONNECTIONS;
+        if (recentCount < TRACKED_CONNECTIONS) {
+            recentCount++;
+        }
+        return false;
+    }
+
+    unsigned long getRequests() const { return requests; }
+    unsigned long getReused() const { return reused; }
+    unsigned long getConnections() const { return requests - reused; }
+
+    // Share of requests served on a reused connection, in percent
+    unsigned int getReusePercent() const {
+        return requests > 0 ? static_cast<unsigned int>(reused * 100UL / requests) : 0;
+    }
+};
+
+#endif // CONNECTION_STATS_H
@@ -0,0 +1,78 @@
+#ifndef CONTROL_COMMAND_QUEUE_H
+#define CONTROL_COMMAND_QUEUE_H
+
+#include <cstddef>
+
+enum ControlCommandType {
+    CONTROL_SET_TARGET,
+    CONTROL_STOP
+};
+
+struct ControlCommand {
+    ControlCommandType type;
+    float position;      // Target for CONTROL_SET_TARGET
+    const char* source;  // Static string for logging, e.g. "Web"
+};
+
+// Platform-independent FIFO of motor commands from network handlers.
+// Handlers only enqueue; the main loop applies the commands between its
+// own tasks, so request handling never drives the motor directly.
+class ControlCommandQueue {
+public:
+    static constexpr size_t CAPACITY = 8;
+
+private:
+    ControlCommand slots[CAPACITY];
+    size_t head;
+    size_t count;
+    unsigned long rejectedCount;
+
+public:
+    ControlCommandQueue()
+        : head(0)
+        , count(0)
+        , rejectedCount(0) {}
+
+    // Whether push() would succeed, so a caller can check before committing
+    // other changes that go with the command
+    bool canAccept(const ControlCommand& command) const {
+        return count < CAPACITY || replacesTail(command);
+    }
+
+    // Returns false when full. A new target replaces a target still waiting
+    // at the tail, so dragging a slider cannot fill the queue.
+    bool push(const ControlCommand& command) {
+        if (replacesTail(command)) {
+            slots[(head + count - 1) % CAPACITY] = command;
+            return true;
+        }
+        if (count == CAPACITY) {
+            rejectedCount++;
+            return false;
+        }
+        slots[(head + count) % CAPACITY] = command;
+        count++;
+        return true;
+    }
+
+    bool pop(ControlCommand& command) {
+        if (count == 0) {
+            return false;
+        }
+        command = slots[head];
+        head = (head + 1) % CAPACITY;
+        count--;
+        return true;
+    }
+
+    bool replacesTail(const ControlCommand& command) const {
+        return count > 0 && command.type == CONTROL_SET_TARGET &&
+               slots[(head + count - 1) % CAPACITY].type == CONTROL_SET_TARGET;
+    }
+
+    size_t size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+    unsigned long getRejectedCount() const { return rejectedCount; }
+};
+
+#endif // CONTROL_COMMAND_QUEUE_H
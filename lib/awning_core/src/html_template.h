@@ -0,0 +1,123 @@
+#ifndef HTML_TEMPLATE_H
+#define HTML_TEMPLATE_H
+
+#include <cstddef>
+#include <cstring>
+
+// Platform-independent streaming renderer for HTML templates with
+// {{name}} placeholders. Output goes through a fixed buffer that is handed
+// to a sink whenever it fills up, so a page of any size is rendered without
+// building it in memory.
+//
+// The template is read one byte at a time through readByte(index), which
+// returns 0 past the end; this lets the firmware read straight from PROGMEM.
+// resolve(name, scratch, scratchSize) returns the value for a placeholder
+// (nullptr for none). Values are HTML-escaped.
+template<size_t N>
+class HtmlTemplateWriter {
+public:
+    static constexpr size_t MAX_NAME_LENGTH = 31;
+    static constexpr size_t SCRATCH_SIZE = 24;
+
+private:
+    char buffer[N];
+    size_t length;
+    size_t totalWritten;
+
+public:
+    HtmlTemplateWriter() : length(0), totalWritten(0) {}
+
+    template<typename Sink>
+    void flush(Sink& sink) {
+        if (length > 0) {
+            sink(buffer, length);
+            totalWritten += length;
+            length = 0;
+        }
+    }
+
+    template<typename Sink>
+    void write(char c, Sink& sink) {
+        buffer[length++] = c;
+        if (length == N) {
+            flush(sink);
+        }
+    }
+
+    template<typename Sink>
+    void write(const char* text, Sink& sink) {
+        while (*text) {
+            write(*text++, sink);
+        }
+    }
+
+    template<typename Sink>
+    void writeEscaped(const char* text, Sink& sink) {
+        for (; *text; text++) {
+            switch (*text) {
+                case '&': write("&amp;", sink); break;
+                case '<': write("&lt;", sink); break;
+                case '>': write("&gt;", sink); break;
+                case '"': write("&quot;", sink); break;
+                case '\'': write("&#39;", sink); break;
+                default: write(*text, sink); break;
+            }
+        }
+    }
+
+    // Renders from position until at least one chunk went to the sink or the
+    // template ended (done is set and the rest flushed). Returns the position
+    // to continue from, so a slow client can be fed a chunk at a time.
+    template<typename ReadByte, typename Resolve, typename Sink>
+    size_t renderStep(ReadByte readByte, Resolve resolve, Sink& sink, size_t position, bool& done) {
+        size_t writtenBefore = totalWritten;
+        size_t i = position;
+        char c;
+        done = false;
+        while (totalWritten == writtenBefore) {
+            c = readByte(i);
+            if (c == '\0') {
+                flush(sink);
+                done = true;
+                return i;
+            }
+            if (c == '{' && readByte(i + 1) == '{') {
+                char name[MAX_NAME_LENGTH + 1];
+                size_t nameLength = 0;
+                size_t j = i + 2;
+                char n;
+                while ((n = readByte(j)) != '\0' && n != '}' && nameLength < MAX_NAME_LENGTH) {
+                    name[nameLength++] = n;
+                    j++;
+                }
+                name[nameLength] = '\0';
+
+                if (n == '}' && readByte(j + 1) == '}') {
+                    char scratch[SCRATCH_SIZE];
+                    const char* value = resolve(name, scratch, sizeof(scratch));
+                    if (value) {
+                        writeEscaped(value, sink);
+                    }
+                    i = j + 2;
+                    continue;
+                }
+            }
+            write(c, sink);
+            i++;
+        }
+        return i;
+    }
+
+    template<typename ReadByte, typename Resolve, typename Sink>
+    void render(ReadByte readByte, Resolve resolve, Sink& sink) {
+        size_t position = 0;
+        bool done = false;
+        while (!done) {
+            position = renderStep(readByte, resolve, sink, position, done);
+        }
+    }
+
+    size_t getTotalWritten() const { return totalWritten; }
+};
+
+#endif // HTML_TEMPLATE_H
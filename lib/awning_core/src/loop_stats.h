@@ -0,0 +1,58 @@
+#ifndef LOOP_STATS_H
+#define LOOP_STATS_H
+
+#include <cstdint>
+
+// Platform-independent main loop timing. Keeps the average and maximum
+// iteration time of the current window plus the worst case and total time
+// since boot.
+class LoopStats {
+private:
+    unsigned long windowCount;
+    unsigned long windowSumUs;
+    unsigned long windowMaxUs;
+    unsigned long peakUs;
+    unsigned long totalCount;
+    uint64_t totalUs;
+
+public:
+    LoopStats()
+        : windowCount(0)
+        , windowSumUs(0)
+        , windowMaxUs(0)
+        , peakUs(0)
+        , totalCount(0)
+        , totalUs(0) {}
+
+    void record(unsigned long durationUs) {
+        // Start a new window before the sum can overflow
+        if (windowSumUs > 0xFFFFFFFFUL - durationUs) {
+            resetWindow();
+        }
+        windowCount++;
+        windowSumUs += durationUs;
+        totalCount++;
+        totalUs += durationUs;
+        if (durationUs > windowMaxUs) {
+            windowMaxUs = durationUs;
+        }
+        if (durationUs > peakUs) {
+            peakUs = durationUs;
+        }
+    }
+
+    void resetWindow() {
+        windowCount = 0;
+        windowSumUs = 0;
+        windowMaxUs = 0;
+    }
+
+    unsigned long getAverageUs() const { return windowCount > 0 ? windowSumUs / windowCount : 0; }
+    unsigned long getMaxUs() const { return windowMaxUs; }
+    unsigned long getPeakUs() const { return peakUs; }
+    unsigned long getWindowCount() const { return windowCount; }
+    unsigned long getTotalCount() const { return totalCount; }
+    uint64_t getTotalUs() const { return totalUs; }
+};
+
+#endif // LOOP_STATS_H
@@ -0,0 +1,117 @@
+#ifndef METRICS_WRITER_H
+#define METRICS_WRITER_H
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+
+// Platform-independent writer for the Prometheus text exposition format.
+// Lines are assembled in a fixed buffer that is handed to a sink whenever
+// the next line would not fit, so the whole scrape is produced without
+// holding it in memory.
+template<size_t N>
+class MetricsWriter {
+public:
+    static constexpr size_t MAX_LINE_LENGTH = 160;
+
+private:
+    char buffer[N];
+    size_t length;
+    size_t totalWritten;
+
+    template<typename Sink>
+    void append(const char* line, size_t lineLength, Sink& sink) {
+        if (length + lineLength > N) {
+            flush(sink);
+        }
+        memcpy(buffer + length, line, lineLength);
+        length += lineLength;
+    }
+
+    // labels is the inside of the braces, e.g. task="web", or nullptr
+    template<typename Sink>
+    void line(const char* name, const char* labels, const char* value, Sink& sink) {
+        char text[MAX_LINE_LENGTH];
+        int len = labels ? snprintf(text, sizeof(text), "%s{%s} %s\n", name, labels, value)
+                         : snprintf(text, sizeof(text), "%s %s\n", name, value);
+        if (len > 0 && (size_t)len < sizeof(text)) {
+            append(text, len, sink);
+        }
+    }
+
+public:
+    static_assert(N >= MAX_LINE_LENGTH, "Buffer must hold at least one line");
+
+    MetricsWriter() : length(0), totalWritten(0) {}
+
+    // HELP and TYPE lines that precede the samples of a metric
+    template<typename Sink>
+    void family(const char* name, const char* type, const char* help, Sink& sink) {
+        char text[MAX_LINE_LENGTH];
+        int len = snprintf(text, sizeof(text), "# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+        if (len > 0 && (size_t)len < sizeof(text)) {
+            append(text, len, sink);
+        }
+    }
+
+    template<typename Sink>
+    void sample(const char* name, const char* labels, unsigned long long value, Sink& sink) {
+        char text[24];
+        snprintf(text, sizeof(text), "%llu", value);
+        line(name, labels, text, sink);
+    }
+
+    template<typename Sink>
+    void sample(const char* name, const char* labels, unsigned long value, Sink& sink) {
+        sample(name, labels, static_cast<unsigned long long>(value), sink);
+    }
+
+    template<typename Sink>
+    void sample(const char* name, const char* labels, unsigned int value, Sink& sink) {
+        sample(name, labels, static_cast<unsigned long long>(value), sink);
+    }
+
+    template<typename Sink>
+    void sample(const char* name, const char* labels, int value, Sink& sink) {
+        sample(name, labels, static_cast<long>(value), sink);
+    }
+
+    template<typename Sink>
+    void sample(const char* name, const char* labels, long value, Sink& sink) {
+        char text[24];
+        snprintf(text, sizeof(text), "%ld", value);
+        line(name, labels, text, sink);
+    }
+
+    template<typename Sink>
+    void sample(const char* name, const char* labels, double value, Sink& sink) {
+        char text[32];
+        snprintf(text, sizeof(text), "%g", value);
+        line(name, labels, text, sink);
+    }
+
+    template<typename Sink>
+    void sample(const char* name, const char* labels, float value, Sink& sink) {
+        sample(name, labels, static_cast<double>(value), sink);
+    }
+
+    // Family with a single unlabelled sample
+    template<typename T, typename Sink>
+    void metric(const char* name, const char* type, const char* help, T value, Sink& sink) {
+        family(name, type, help, sink);
+        sample(name, nullptr, value, sink);
+    }
+
+    template<typename Sink>
+    void flush(Sink& sink) {
+        if (length > 0) {
+            sink(buffer, length);
+            totalWritten += length;
+            length = 0;
+        }
+    }
+
+    size_t getTotalWritten() const { return totalWritten; }
+};
+
+#endif // METRICS_WRITER_H
@@ -42,6 +42,8 @@ private:
     uint8_t activePulseRelay;
     uint8_t lastMovementRelay;
     unsigned long motorStartTime;
+    unsigned long lastActivationTime;  // When a relay was last switched on
+    unsigned long activationCount;
 
     static constexpr unsigned long RELAY_SETTLING_TIME_MS = 100;
 
@@ -54,6 +56,8 @@ private:
         activePulseRelay = relayPin;
         pulseDuration = duration;
         pulseStartTime = timeProvider ? timeProvider->millis() : 0;
+        lastActivationTime = pulseStartTime;
+        activationCount++;
         pulseState = (duration == MOTOR_START_PULSE_MS) ?
                      MOTOR_PULSE_START_ACTIVE : MOTOR_PULSE_STOP_ACTIVE;
     }
@@ -84,7 +88,9 @@ public:
         , pulseDuration(0)
         , activePulseRelay(0)
         , lastMovementRelay(PIN_RELAY_EXTEND)
-        , motorStartTime(0) {
+        , motorStartTime(0)
+        , lastActivationTime(0)
+        , activationCount(0) {
     }
 
     void update(unsigned long currentTimeMs) {
@@ -168,6 +174,14 @@ public:
         return lastMovementRelay;
     }
 
+    unsigned long getLastActivationTime() const {
+        return lastActivationTime;
+    }
+
+    unsigned long getActivationCount() const {
+        return activationCount;
+    }
+
     unsigned long getRunTime() const {
         if (!isMoving() || !timeProvider) {
             return 0;
@@ -0,0 +1,489 @@
+#ifndef MQTT_COMMAND_H
+#define MQTT_COMMAND_H
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Platform-independent handling of MQTT commands: which command topic a
+// message arrived on, decoding of plain, wrapped and JSON payloads, dispatch
+// to the callbacks, and the ack payload. MqttHandler and the host benchmark
+// (bench/mqtt_bench) share it, so the benchmark runs the firmware's logic.
+//
+// Plain topics take the value as the whole payload ("OPEN", "42.5") or
+// wrapped as {"value":..., "ts":<unix seconds>, "id":...}. The command topic
+// takes {"command":..., "position":..., "wind_threshold":..., "ts":..., "id":...}.
+
+// Outcome of a command callback, reported on the ack topic
+struct CommandResult {
+    bool accepted;
+    const char* reason;  // nullptr when accepted
+};
+
+// Fields of a JSON command; absent fields are left unchanged
+struct JsonCommand {
+    const char* command;     // OPEN/CLOSE/STOP or nullptr
+    bool hasPosition;
+    float position;
+    bool hasWindThreshold;
+    float windThreshold;
+};
+
+enum MqttCommandTopic {
+    MQTT_COMMAND_NONE,
+    MQTT_COMMAND_SET,                 // <base>/set
+    MQTT_COMMAND_SET_POSITION,        // <base>/set_position
+    MQTT_COMMAND_SET_WIND_THRESHOLD,  // <base>/set_wind_threshold
+    MQTT_COMMAND_JSON,                // <base>/command
+    MQTT_COMMAND_TOPIC_COUNT
+};
+
+// Topic below the base topic, and the name reported in acks, in enum order
+const char* const MQTT_COMMAND_SUFFIXES[MQTT_COMMAND_TOPIC_COUNT] = {
+    "", "/set", "/set_position", "/set_wind_threshold", "/command"};
+const char* const MQTT_COMMAND_NAMES[MQTT_COMMAND_TOPIC_COUNT] = {
+    "", "set", "set_position", "set_wind_threshold", "command"};
+
+inline MqttCommandTopic mqttCommandForTopic(const char* topic, const char* baseTopic) {
+    size_t baseLength = strlen(baseTopic);
+    if (strncmp(topic, baseTopic, baseLength) != 0) {
+        return MQTT_COMMAND_NONE;
+    }
+    for (int i = MQTT_COMMAND_SET; i < MQTT_COMMAND_TOPIC_COUNT; i++) {
+        if (strcmp(topic + baseLength, MQTT_COMMAND_SUFFIXES[i]) == 0) {
+            return static_cast<MqttCommandTopic>(i);
+        }
+    }
+    return MQTT_COMMAND_NONE;
+}
+
+enum FlatJsonType {
+    FLAT_JSON_STRING,
+    FLAT_JSON_NUMBER,
+    FLAT_JSON_BOOL,
+    FLAT_JSON_NULL,
+    FLAT_JSON_NESTED  // Object or array
+};
+
+// A member value as it appears in the payload; strings include their quotes
+struct FlatJsonValue {
+    FlatJsonType type;
+    const char* text;
+    size_t length;
+    bool integral;  // Numbers without fraction or exponent
+};
+
+// Reads the members of a single JSON object without allocating. Nested
+// values are skipped and reported as FLAT_JSON_NESTED.
+class FlatJsonReader {
+private:
+    const char* text;
+    size_t length;
+    size_t pos;
+
+    bool atEnd() const { return pos >= length; }
+    char peek() const { return atEnd() ? '\0' : text[pos]; }
+
+    void skipSpace() {
+        while (!atEnd() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r')) {
+            pos++;
+        }
+    }
+
+    bool readString() {
+        if (peek() != '"') {
+            return false;
+        }
+        for (pos++; !atEnd(); pos++) {
+            if (text[pos] == '\\') {
+                pos++;
+            } else if (text[pos] == '"') {
+                pos++;
+                return true;
+            } else if ((unsigned char)text[pos] < 0x20) {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    bool readDigits() {
+        size_t start = pos;
+        while (peek() >= '0' && peek() <= '9') {
+            pos++;
+        }
+        return pos > start;
+    }
+
+    bool readNumber(bool& integral) {
+        integral = true;
+        if (peek() == '-') {
+            pos++;
+        }
+        if (!readDigits()) {
+            return false;
+        }
+        if (peek() == '.') {
+            pos++;
+            integral = false;
+            if (!readDigits()) {
+                return false;
+            }
+        }
+        if (peek() == 'e' || peek() == 'E') {
+            pos++;
+            integral = false;
+            if (peek() == '+' || peek() == '-') {
+                pos++;
+            }
+            if (!readDigits()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool readWord(const char* word) {
+        size_t wordLength = strlen(word);
+        if (length - pos < wordLength || strncmp(text + pos, word, wordLength) != 0) {
+            return false;
+        }
+        pos += wordLength;
+        return true;
+    }
+
+    // Skips an object or array, minding brackets inside strings
+    bool skipNested() {
+        int depth = 0;
+        while (!atEnd()) {
+            char c = text[pos];
+            if (c == '"') {
+                if (!readString()) {
+                    return false;
+                }
+                continue;
+            }
+            pos++;
+            if (c == '{' || c == '[') {
+                depth++;
+            } else if (c == '}' || c == ']') {
+                if (--depth == 0) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    bool readValue(FlatJsonValue& value) {
+        size_t start = pos;
+        bool ok;
+        value.integral = false;
+        switch (peek()) {
+            case '"': value.type = FLAT_JSON_STRING; ok = readString(); break;
+            case '{':
+            case '[': value.type = FLAT_JSON_NESTED; ok = skipNested(); break;
+            case 't': value.type = FLAT_JSON_BOOL; ok = readWord("true"); break;
+            case 'f': value.type = FLAT_JSON_BOOL; ok = readWord("false"); break;
+            case 'n': value.type = FLAT_JSON_NULL; ok = readWord("null"); break;
+            default: value.type = FLAT_JSON_NUMBER; ok = readNumber(value.integral); break;
+        }
+        value.text = text + start;
+        value.length = pos - start;
+        return ok;
+    }
+
+public:
+    FlatJsonReader(const char* json, size_t jsonLength) : text(json), length(jsonLength), pos(0) {}
+
+    // Calls visit(key, keyLength, value) for every member, keys without
+    // quotes. Returns false unless the whole input is one valid object.
+    template<typename Visit>
+    bool forEachMember(Visit visit) {
+        pos = 0;
+        skipSpace();
+        if (peek() != '{') {
+            return false;
+        }
+        pos++;
+        skipSpace();
+        if (peek() == '}') {
+            pos++;
+        } else {
+            while (true) {
+                size_t keyStart = pos + 1;
+                if (!readString()) {
+                    return false;
+                }
+                size_t keyLength = pos - 1 - keyStart;
+                skipSpace();
+                if (peek() != ':') {
+                    return false;
+                }
+                pos++;
+                skipSpace();
+                FlatJsonValue value;
+                if (!readValue(value)) {
+                    return false;
+                }
+                visit(text + keyStart, keyLength, value);
+                skipSpace();
+                if (peek() == ',') {
+                    pos++;
+                    skipSpace();
+                    continue;
+                }
+                if (peek() != '}') {
+                    return false;
+                }
+                pos++;
+                break;
+            }
+        }
+        skipSpace();
+        return atEnd();
+    }
+
+    static bool keyIs(const char* key, size_t keyLength, const char* name) {
+        return strlen(name) == keyLength && strncmp(key, name, keyLength) == 0;
+    }
+
+    // Copies a string value without its quotes, resolving simple escapes.
+    // Fails when it does not fit.
+    static bool copyString(const FlatJsonValue& value, char* out, size_t size) {
+        size_t written = 0;
+        for (size_t i = 1; i + 1 < value.length; i++) {
+            char c = value.text[i];
+            if (c == '\\' && i + 2 < value.length) {
+                c = value.text[++i];
+                switch (c) {
+                    case 'n': c = '\n'; break;
+                    case 't': c = '\t'; break;
+                    case 'r': c = '\r'; break;
+                    case 'b': c = '\b'; break;
+                    case 'f': c = '\f'; break;
+                    default: break;  // \" \\ \/ stand for themselves
+                }
+            }
+            if (written + 1 >= size) {
+                return false;
+            }
+            out[written++] = c;
+        }
+        out[written] = '\0';
+        return true;
+    }
+};
+
+// A decoded command, ready for dispatch
+struct MqttCommand {
+    static constexpr size_t MAX_ID_LENGTH = 23;     // As JSON, quotes included
+    static constexpr size_t MAX_VALUE_LENGTH = 31;
+
+    MqttCommandTopic topic;
+    char id[MAX_ID_LENGTH + 1];         // Echoed verbatim in the ack, empty for none
+    unsigned long timestamp;            // Unix seconds from "ts", 0 for none
+    char value[MAX_VALUE_LENGTH + 1];   // Plain topics: the unwrapped value
+    float number;                       // set_position and set_wind_threshold
+    JsonCommand json;                   // Command topic; json.command points into value
+
+    const char* getId() const { return id[0] ? id : nullptr; }
+};
+
+// Parses all of text (surrounding spaces allowed) as a number
+inline bool parseMqttNumber(const char* text, float& number) {
+    char* end = nullptr;
+    double parsed = strtod(text, &end);
+    if (end == text) {
+        return false;
+    }
+    while (*end == ' ') {
+        end++;
+    }
+    if (*end != '\0' || parsed != parsed) {
+        return false;
+    }
+    number = static_cast<float>(parsed);
+    return true;
+}
+
+inline bool copyMqttToken(const FlatJsonValue& value, char* out, size_t size) {
+    if (value.length >= size) {
+        return false;
+    }
+    memcpy(out, value.text, value.length);
+    out[value.length] = '\0';
+    return true;
+}
+
+// Decodes a payload (need not be terminated) received on topic. Returns an
+// accepted result when the command is well formed and recent, otherwise the
+// rejection to ack. nowEpoch is the wall clock in Unix seconds, 0 while it is
+// not synced; timestamped commands older than maxAgeS are then rejected.
+inline CommandResult decodeMqttCommand(MqttCommandTopic topic, const char* payload, size_t length,
+                                       unsigned long nowEpoch, unsigned long maxAgeS, MqttCommand& command) {
+    command.topic = topic;
+    command.id[0] = '\0';
+    command.timestamp = 0;
+    command.value[0] = '\0';
+    command.number = 0.0f;
+    command.json = {nullptr, false, 0.0f, false, 0.0f};
+
+    bool isPlainTopic = topic != MQTT_COMMAND_JSON;
+    bool isNumberTopic = topic == MQTT_COMMAND_SET_POSITION || topic == MQTT_COMMAND_SET_WIND_THRESHOLD;
+
+    if (isPlainTopic && (length == 0 || payload[0] != '{')) {
+        if (length > MqttCommand::MAX_VALUE_LENGTH) {
+            return {false, "invalid_value"};
+        }
+        memcpy(command.value, payload, length);
+        command.value[length] = '\0';
+    } else {
+        FlatJsonValue id = {FLAT_JSON_NULL, nullptr, 0, false};
+        FlatJsonValue ts = id;
+        FlatJsonValue value = id;
+        FlatJsonValue motor = id;
+        FlatJsonValue position = id;
+        FlatJsonValue threshold = id;
+        bool hasValue = false;
+        FlatJsonReader reader(payload, length);
+        bool valid = reader.forEachMember([&](const char* key, size_t keyLength, const FlatJsonValue& member) {
+            if (FlatJsonReader::keyIs(key, keyLength, "id")) {
+                id = member;
+            } else if (FlatJsonReader::keyIs(key, keyLength, "ts")) {
+                ts = member;
+            } else if (FlatJsonReader::keyIs(key, keyLength, "value")) {
+                value = member;
+                hasValue = true;
+            } else if (FlatJsonReader::keyIs(key, keyLength, "command")) {
+                motor = member;
+            } else if (FlatJsonReader::keyIs(key, keyLength, "position")) {
+                position = member;
+            } else if (FlatJsonReader::keyIs(key, keyLength, "wind_threshold")) {
+                threshold = member;
+            }
+        });
+        if (!valid) {
+            return {false, "invalid_json"};
+        }
+
+        // Echo the id verbatim, whether it is a number or a string; a
+        // cut-off token would make the ack invalid JSON
+        if (id.type != FLAT_JSON_NULL && !copyMqttToken(id, command.id, sizeof(command.id))) {
+            return {false, "invalid_id"};
+        }
+
+        // Only a non-negative integer counts as a timestamp
+        if (ts.type == FLAT_JSON_NUMBER && ts.integral && ts.text[0] != '-') {
+            command.timestamp = strtoul(ts.text, nullptr, 10);
+        }
+        if (command.timestamp != 0 && nowEpoch != 0 && nowEpoch > command.timestamp &&
+            nowEpoch - command.timestamp > maxAgeS) {
+            return {false, "stale"};
+        }
+
+        if (isPlainTopic) {
+            // A missing, null, bool or nested value must not turn into 0 (retract)
+            bool copied = false;
+            if (hasValue && value.type == FLAT_JSON_STRING) {
+                copied = FlatJsonReader::copyString(value, command.value, sizeof(command.value));
+            } else if (hasValue && value.type == FLAT_JSON_NUMBER) {
+                copied = copyMqttToken(value, command.value, sizeof(command.value));
+            }
+            if (!copied) {
+                return {false, "invalid_value"};
+            }
+        } else {
+            if (motor.type != FLAT_JSON_NULL) {
+                if (motor.type != FLAT_JSON_STRING ||
+                    !FlatJsonReader::copyString(motor, command.value, sizeof(command.value))) {
+                    return {false, "invalid_type"};
+                }
+                command.json.command = command.value;
+            }
+            char number[MqttCommand::MAX_VALUE_LENGTH + 1];
+            if (position.type != FLAT_JSON_NULL) {
+                if (position.type != FLAT_JSON_NUMBER || !copyMqttToken(position, number, sizeof(number)) ||
+                    !parseMqttNumber(number, command.json.position)) {
+                    return {false, "invalid_type"};
+                }
+                command.json.hasPosition = true;
+            }
+            if (threshold.type != FLAT_JSON_NULL) {
+                if (threshold.type != FLAT_JSON_NUMBER || !copyMqttToken(threshold, number, sizeof(number)) ||
+                    !parseMqttNumber(number, command.json.windThreshold)) {
+                    return {false, "invalid_type"};
+                }
+                command.json.hasWindThreshold = true;
+            }
+            if (!command.json.command && !command.json.hasPosition && !command.json.hasWindThreshold) {
+                return {false, "empty"};
+            }
+        }
+    }
+
+    if (isNumberTopic && !parseMqttNumber(command.value, command.number)) {
+        return {false, "invalid_value"};
+    }
+    return {true, nullptr};
+}
+
+// Hands a decoded command to the matching callback of handlers, which has
+// std::function members onCommand(const char*), onSetPosition(float),
+// onSetWindThreshold(float) and onJsonCommand(const JsonCommand&).
+// A callback that is not set answers "unsupported".
+template<typename Handlers>
+CommandResult dispatchMqttCommand(const MqttCommand& command, const Handlers& handlers) {
+    switch (command.topic) {
+        case MQTT_COMMAND_SET:
+            if (handlers.onCommand) {
+                return handlers.onCommand(command.value);
+            }
+            break;
+        case MQTT_COMMAND_SET_POSITION:
+            if (handlers.onSetPosition) {
+                return handlers.onSetPosition(command.number);
+            }
+            break;
+        case MQTT_COMMAND_SET_WIND_THRESHOLD:
+            if (handlers.onSetWindThreshold) {
+                return handlers.onSetWindThreshold(command.number);
+            }
+            break;
+        case MQTT_COMMAND_JSON:
+            if (handlers.onJsonCommand) {
+                return handlers.onJsonCommand(command.json);
+            }
+            break;
+        default:
+            break;
+    }
+    return {false, "unsupported"};
+}
+
+// Ack payload for a command, e.g.
+// {"id":17,"cmd":"set","result":"accepted","latency_ms":3,"handled_ms":4}
+// latencyMs is the time to the first relay switched on by the command, or
+// negative when it did not start the motor. Returns the payload length.
+inline int formatMqttAck(char* buffer, size_t size, MqttCommandTopic topic, const char* id,
+                         const CommandResult& result, long latencyMs, unsigned long handledMs) {
+    int len = snprintf(buffer, size, "{\"id\":%s,\"cmd\":\"%s\",\"result\":\"%s\"",
+                       id ? id : "null", MQTT_COMMAND_NAMES[topic], result.accepted ? "accepted" : "rejected");
+    if (!result.accepted && result.reason && len >= 0 && (size_t)len < size) {
+        len += snprintf(buffer + len, size - len, ",\"reason\":\"%s\"", result.reason);
+    }
+    if (len >= 0 && (size_t)len < size) {
+        if (latencyMs >= 0) {
+            len += snprintf(buffer + len, size - len, ",\"latency_ms\":%ld", latencyMs);
+        } else {
+            len += snprintf(buffer + len, size - len, ",\"latency_ms\":null");
+        }
+    }
+    if (len >= 0 && (size_t)len < size) {
+        len += snprintf(buffer + len, size - len, ",\"handled_ms\":%lu}", handledMs);
+    }
+    return len;
+}
+
+#endif // MQTT_COMMAND_H
@@ -0,0 +1,214 @@
+#ifndef MQTT_OUTBOUND_QUEUE_H
+#define MQTT_OUTBOUND_QUEUE_H
+
+#include <cstddef>
+#include <cstring>
+
+// Message kinds - state topics keep only their latest value,
+// events are appended in order
+enum OutboundKind {
+    OUTBOUND_STATE,
+    OUTBOUND_EVENT
+};
+
+struct OutboundMessage {
+    static constexpr size_t PAYLOAD_SIZE = 64;
+
+    const char* topic;  // Points at a topic buffer owned by the caller
+    char payload[PAYLOAD_SIZE];
+    OutboundKind kind;
+    bool retained;
+    bool important;     // Kept in flight until the ack window has passed
+    bool inflight;
+    unsigned long sentAt;
+};
+
+// Platform-independent bounded ring of pending outbound MQTT messages.
+// Messages produced while disconnected are held here and flushed at a
+// limited rate once the connection is back.
+class MqttOutboundQueue {
+public:
+    static constexpr size_t CAPACITY = 12;
+
+private:
+    OutboundMessage slots[CAPACITY];
+    size_t head;
+    size_t count;
+    size_t burst;
+    unsigned long flushIntervalMs;
+    unsigned long lastFlushTime;
+    bool flushedOnce;
+    unsigned long droppedCount;
+
+    OutboundMessage& at(size_t index) { return slots[(head + index) % CAPACITY]; }
+    const OutboundMessage& at(size_t index) const { return slots[(head + index) % CAPACITY]; }
+
+    void removeAt(size_t index) {
+        if (index == 0) {
+            head = (head + 1) % CAPACITY;
+            count--;
+            return;
+        }
+        for (size_t i = index; i + 1 < count; i++) {
+            at(i) = at(i + 1);
+        }
+        count--;
+    }
+
+    // Evict the oldest unimportant message, or the oldest message if all are important
+    void evictOne() {
+        for (size_t i = 0; i < count; i++) {
+            if (!at(i).important) {
+                removeAt(i);
+                droppedCount++;
+                return;
+            }
+        }
+        removeAt(0);
+        droppedCount++;
+    }
+
+    static void copyPayload(OutboundMessage& msg, const char* payload) {
+        strncpy(msg.payload, payload, OutboundMessage::PAYLOAD_SIZE - 1);
+        msg.payload[OutboundMessage::PAYLOAD_SIZE - 1] = '\0';
+    }
+
+    bool push(const char* topic, const char* payload, OutboundKind kind, bool retained, bool important) {
+        if (!topic || !payload) {
+            return false;
+        }
+        if (count == CAPACITY) {
+            evictOne();
+        }
+
+        OutboundMessage& msg = at(count);
+        msg.topic = topic;
+        copyPayload(msg, payload);
+        msg.kind = kind;
+        msg.retained = retained;
+        msg.important = important;
+        msg.inflight = false;
+        msg.sentAt = 0;
+        count++;
+        return true;
+    }
+
+public:
+    MqttOutboundQueue()
+        : head(0)
+        , count(0)
+        , burst(4)
+        , flushIntervalMs(100)
+        , lastFlushTime(0)
+        , flushedOnce(false)
+        , droppedCount(0) {}
+
+    void setRateLimit(size_t messagesPerFlush, unsigned long intervalMs) {
+        burst = messagesPerFlush > 0 ? messagesPerFlush : 1;
+        flushIntervalMs = intervalMs;
+    }
+
+    // Latest-wins: replaces a pending message for the same topic
+    bool enqueueState(const char* topic, const char* payload, bool retained) {
+        if (!topic || !payload) {
+            return false;
+        }
+        for (size_t i = 0; i < count; i++) {
+            OutboundMessage& msg = at(i);
+            if (msg.kind == OUTBOUND_STATE && !msg.inflight && strcmp(msg.topic, topic) == 0) {
+                copyPayload(msg, payload);
+                msg.retained = retained;
+                return true;
+            }
+        }
+        return push(topic, payload, OUTBOUND_STATE, retained, false);
+    }
+
+    bool enqueueEvent(const char* topic, const char* payload, bool retained, bool important) {
+        return push(topic, payload, OUTBOUND_EVENT, retained, important);
+    }
+
+    // Publish pending messages in order, at most `burst` per flush interval.
+    // publish(topic, payload, retained) returns false if the write failed,
+    // which stops the flush and keeps the message queued.
+    template<typename PublishFn>
+    size_t flush(unsigned long now, PublishFn publish) {
+        if (flushedOnce && now - lastFlushTime < flushIntervalMs) {
+            return 0;
+        }
+
+        size_t sent = 0;
+        size_t i = 0;
+        while (i < count && sent < burst) {
+            OutboundMessage& msg = at(i);
+            if (msg.inflight) {
+                i++;
+                continue;
+            }
+            if (!publish(msg.topic, msg.payload, msg.retained)) {
+                break;
+            }
+            sent++;
+            if (msg.important) {
+                msg.inflight = true;
+                msg.sentAt = now;
+                i++;
+            } else {
+                removeAt(i);
+            }
+        }
+
+        if (sent > 0) {
+            lastFlushTime = now;
+            flushedOnce = true;
+        }
+        return sent;
+    }
+
+    // Retire in-flight messages once the connection survived the ack window
+    void settle(unsigned long now, unsigned long ackWindowMs) {
+        size_t i = 0;
+        while (i < count) {
+            const OutboundMessage& msg = at(i);
+            if (msg.inflight && now - msg.sentAt >= ackWindowMs) {
+                removeAt(i);
+            } else {
+                i++;
+            }
+        }
+    }
+
+    // Connection dropped - anything still in flight must be sent again
+    void onConnectionLost() {
+        for (size_t i = 0; i < count; i++) {
+            at(i).inflight = false;
+        }
+    }
+
+    void clear() {
+        head = 0;
+        count = 0;
+    }
+
+    size_t size() const { return count; }
+    bool isEmpty() const { return count == 0; }
+    unsigned long getDroppedCount() const { return droppedCount; }
+
+    size_t getPendingCount() const {
+        size_t pending = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (!at(i).inflight) {
+                pending++;
+            }
+        }
+        return pending;
+    }
+
+    size_t getInflightCount() const { return count - getPendingCount(); }
+
+    const OutboundMessage* peek(size_t index) const {
+        return index < count ? &at(index) : nullptr;
+    }
+};
+
+#endif // MQTT_OUTBOUND_QUEUE_H
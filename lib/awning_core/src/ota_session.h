@@ -0,0 +1,140 @@
+#ifndef OTA_SESSION_H
+#define OTA_SESSION_H
+
+#include <cstddef>
+#include <cstdint>
+#include "loop_stats.h"
+
+enum OtaState {
+    OTA_IDLE,
+    OTA_RECEIVING,
+    OTA_SUCCEEDED,
+    OTA_FAILED
+};
+
+// Platform-independent bookkeeping for a streamed firmware upload: progress,
+// throughput and the gaps between safety task runs while the image is being
+// written, so the cost of an update on the control loop can be reported.
+class OtaSession {
+public:
+    static constexpr size_t MD5_LENGTH = 32;
+
+private:
+    OtaState state;
+    uint32_t expectedSize;
+    uint32_t received;
+    unsigned long startMs;
+    unsigned long endMs;
+    const char* error;
+    LoopStats safetyGaps;
+    unsigned long lastTickUs;
+    bool hasTick;
+
+public:
+    OtaSession()
+        : state(OTA_IDLE)
+        , expectedSize(0)
+        , received(0)
+        , startMs(0)
+        , endMs(0)
+        , error(nullptr)
+        , lastTickUs(0)
+        , hasTick(false) {}
+
+    // An MD5 digest as 32 hex digits
+    static bool isValidMd5(const char* md5) {
+        if (!md5) {
+            return false;
+        }
+        size_t i = 0;
+        for (; md5[i]; i++) {
+            char c = md5[i];
+            bool hex = (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+            if (!hex || i >= MD5_LENGTH) {
+                return false;
+            }
+        }
+        return i == MD5_LENGTH;
+    }
+
+    static const char* stateName(OtaState state) {
+        switch (state) {
+            case OTA_RECEIVING: return "receiving";
+            case OTA_SUCCEEDED: return "succeeded";
+            case OTA_FAILED: return "failed";
+            default: return "idle";
+        }
+    }
+
+    // expectedSize is 0 when the client did not announce it
+    void begin(unsigned long nowMs, uint32_t size) {
+        state = OTA_RECEIVING;
+        expectedSize = size;
+        received = 0;
+        startMs = nowMs;
+        endMs = nowMs;
+        error = nullptr;
+        safetyGaps = LoopStats();
+        hasTick = false;
+    }
+
+    void onData(size_t length, unsigned long nowMs) {
+        if (state == OTA_RECEIVING) {
+            received += length;
+            endMs = nowMs;
+        }
+    }
+
+    // Called each time the safety tasks ran during the upload
+    void onSafetyTick(unsigned long nowUs) {
+        if (state != OTA_RECEIVING) {
+            return;
+        }
+        if (hasTick) {
+            safetyGaps.record(nowUs - lastTickUs);
+        }
+        lastTickUs = nowUs;
+        hasTick = true;
+    }
+
+    void succeed(unsigned long nowMs) {
+        if (state == OTA_RECEIVING) {
+            state = OTA_SUCCEEDED;
+            endMs = nowMs;
+        }
+    }
+
+    // The first failure is kept; later ones are consequences of it
+    void fail(const char* reason, unsigned long nowMs) {
+        if (state == OTA_RECEIVING) {
+            state = OTA_FAILED;
+            error = reason;
+            endMs = nowMs;
+        }
+    }
+
+    OtaState getState() const { return state; }
+    bool isActive() const { return state == OTA_RECEIVING; }
+    uint32_t getReceived() const { return received; }
+    uint32_t getExpectedSize() const { return expectedSize; }
+    const char* getError() const { return error; }
+    unsigned long getElapsedMs() const { return endMs - startMs; }
+
+    unsigned long getThroughputBps() const {
+        unsigned long elapsed = getElapsedMs();
+        return elapsed > 0 ? (unsigned long)((uint64_t)received * 1000 / elapsed) : 0;
+    }
+
+    // Percent of the announced size, or 0 when unknown
+    uint8_t getPercent() const {
+        if (expectedSize == 0) {
+            return 0;
+        }
+        uint64_t percent = (uint64_t)received * 100 / expectedSize;
+        return percent > 100 ? 100 : (uint8_t)percent;
+    }
+
+    const LoopStats& getSafetyGaps() const { return safetyGaps; }
+};
+
+#endif // OTA_SESSION_H
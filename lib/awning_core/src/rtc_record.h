@@ -0,0 +1,45 @@
+#ifndef RTC_RECORD_H
+#define RTC_RECORD_H
+
+#include <cstddef>
+#include <cstdint>
+
+// CRC-32 (IEEE 802.3, reflected), bitwise so it needs no table in RAM
+inline uint32_t rtcCrc32(const void* data, size_t length, uint32_t crc = 0) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+// A payload as kept in the ESP8266's RTC user memory, which survives
+// resets but not power loss and starts out as garbage. The magic tells
+// records apart and changes with the payload layout; the CRC rejects
+// anything not written by seal(). Sizes are whole 4-byte blocks, as
+// ESP.rtcUserMemoryRead/Write require.
+template<typename T>
+struct RtcRecord {
+    uint32_t magic;
+    uint32_t crc;
+    T payload;
+
+    void seal(uint32_t recordMagic) {
+        magic = recordMagic;
+        crc = rtcCrc32(&payload, sizeof(payload));
+    }
+
+    bool isValid(uint32_t recordMagic) const {
+        return magic == recordMagic && crc == rtcCrc32(&payload, sizeof(payload));
+    }
+
+    void invalidate() {
+        magic = 0;
+    }
+};
+
+#endif // RTC_RECORD_H
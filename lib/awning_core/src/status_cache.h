@@ -0,0 +1,68 @@
+#ifndef STATUS_CACHE_H
+#define STATUS_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include "status_delta.h"
+#include "status_cbor.h"
+
+// Encoded /status kept in fixed buffers and re-encoded only when the
+// encoded form would change. The version increments with every change, so
+// any number of pollers of an unchanged state share the same bytes. Each
+// format is encoded on first request for a version.
+template<size_t N>
+class StatusCache {
+private:
+    StatusDeltaEncoder encoder;
+    StatusSnapshot cached;
+    unsigned long version;
+    char json[N];
+    size_t jsonLength;
+    unsigned long jsonVersion;
+    uint8_t cbor[N];
+    size_t cborLength;
+    unsigned long cborVersion;
+
+    void refresh(const StatusSnapshot& current) {
+        if (version == 0 || !StatusDeltaEncoder::sameAsEncoded(current, cached)) {
+            cached = current;
+            version++;
+        }
+    }
+
+public:
+    StatusCache()
+        : cached()
+        , version(0)
+        , jsonLength(0)
+        , jsonVersion(0)
+        , cborLength(0)
+        , cborVersion(0) {
+        json[0] = '\0';
+    }
+
+    // Returns the JSON for current (length via the argument); empty if N is too small
+    const char* getJson(const StatusSnapshot& current, size_t& length) {
+        refresh(current);
+        if (jsonVersion != version) {
+            jsonLength = encoder.encodeFull(cached, json, sizeof(json));
+            jsonVersion = version;
+        }
+        length = jsonLength;
+        return json;
+    }
+
+    const uint8_t* getCbor(const StatusSnapshot& current, size_t& length) {
+        refresh(current);
+        if (cborVersion != version) {
+            cborLength = encodeStatusCbor(cached, cbor, sizeof(cbor));
+            cborVersion = version;
+        }
+        length = cborLength;
+        return cbor;
+    }
+
+    unsigned long getVersion() const { return version; }
+};
+
+#endif // STATUS_CACHE_H
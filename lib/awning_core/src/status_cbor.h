@@ -0,0 +1,104 @@
+#ifndef STATUS_CBOR_H
+#define STATUS_CBOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include "status_delta.h"
+
+// Minimal CBOR (RFC 8949) writer into a fixed buffer. Supports just what
+// the status map needs; once the buffer is too small, further writes are
+// dropped and ok() turns false.
+class CborWriter {
+private:
+    uint8_t* buffer;
+    size_t size;
+    size_t length;
+    bool overflow;
+
+    void put(uint8_t byte) {
+        if (length < size) {
+            buffer[length++] = byte;
+        } else {
+            overflow = true;
+        }
+    }
+
+    // Major type with its argument in the shortest form
+    void head(uint8_t major, uint32_t value) {
+        major <<= 5;
+        if (value < 24) {
+            put(major | value);
+        } else if (value <= 0xFF) {
+            put(major | 24);
+            put(value);
+        } else if (value <= 0xFFFF) {
+            put(major | 25);
+            put(value >> 8);
+            put(value);
+        } else {
+            put(major | 26);
+            put(value >> 24);
+            put(value >> 16);
+            put(value >> 8);
+            put(value);
+        }
+    }
+
+public:
+    CborWriter(uint8_t* out, size_t outSize)
+        : buffer(out)
+        , size(outSize)
+        , length(0)
+        , overflow(false) {}
+
+    void map(uint32_t entries) { head(5, entries); }
+    void uint(uint32_t value) { head(0, value); }
+    void boolean(bool value) { put(value ? 0xF5 : 0xF4); }
+
+    void text(const char* value) {
+        size_t len = strlen(value);
+        head(3, len);
+        for (size_t i = 0; i < len; i++) {
+            put(value[i]);
+        }
+    }
+
+    // Single precision is exact enough for one-decimal positions
+    void float32(float value) {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        put(0xFA);
+        put(bits >> 24);
+        put(bits >> 16);
+        put(bits >> 8);
+        put(bits);
+    }
+
+    bool ok() const { return !overflow; }
+    size_t getLength() const { return overflow ? 0 : length; }
+};
+
+// The /status fields as a CBOR map with the same keys and rounding as the
+// JSON. Returns the length, or 0 if size is too small.
+inline size_t encodeStatusCbor(const StatusSnapshot& status, uint8_t* buffer, size_t size) {
+    CborWriter cbor(buffer, size);
+    cbor.map(7);
+    cbor.text("position");
+    cbor.float32(StatusDeltaEncoder::roundToDisplay(status.position));
+    cbor.text("target");
+    cbor.float32(StatusDeltaEncoder::roundToDisplay(status.target));
+    cbor.text("motor");
+    cbor.text(StatusDeltaEncoder::motorName(status.motor));
+    cbor.text("windPulses");
+    cbor.uint(status.windPulses);
+    cbor.text("windThreshold");
+    cbor.uint(status.windThreshold);
+    cbor.text("travelTime");
+    cbor.uint(status.travelTime);
+    cbor.text("calibrating");
+    cbor.boolean(status.calibrating);
+    return cbor.getLength();
+}
+
+#endif // STATUS_CBOR_H
@@ -0,0 +1,154 @@
+#ifndef STATUS_DELTA_H
+#define STATUS_DELTA_H
+
+#include <cstddef>
+#include <cstdio>
+#include "awning_types.h"
+
+// Values shown by the web UI
+struct StatusSnapshot {
+    float position;
+    float target;
+    AwningState motor;
+    unsigned long windPulses;
+    unsigned long windThreshold;
+    unsigned long travelTime;
+    bool calibrating;
+};
+
+// Platform-independent encoder for pushed status updates.
+// Produces a JSON object containing only the fields that changed since the
+// previous update, using the same keys as the /status endpoint.
+class StatusDeltaEncoder {
+private:
+    StatusSnapshot last;
+    bool hasLast;
+    unsigned long lastPushTime;
+
+    // Positions are shown with one decimal; smaller changes are not worth a push
+    static long tenths(float value) {
+        return static_cast<long>(value * 10.0f + (value >= 0.0f ? 0.5f : -0.5f));
+    }
+
+    // Appends one "key":value pair; len runs past size on overflow
+    static void append(char* buffer, size_t size, size_t& len, bool& first, const char* field) {
+        if (len < size) {
+            len += snprintf(buffer + len, size - len, first ? "%s" : ",%s", field);
+        }
+        first = false;
+    }
+
+    size_t encode(const StatusSnapshot& current, char* buffer, size_t size, bool full) const {
+        if (size < 3) {
+            return 0;
+        }
+
+        char field[32];
+        size_t len = 0;
+        bool first = true;
+        buffer[len++] = '{';
+        buffer[len] = '\0';
+
+        if (full || tenths(current.position) != tenths(last.position)) {
+            snprintf(field, sizeof(field), "\"position\":%.1f", current.position);
+            append(buffer, size, len, first, field);
+        }
+        if (full || tenths(current.target) != tenths(last.target)) {
+            snprintf(field, sizeof(field), "\"target\":%.1f", current.target);
+            append(buffer, size, len, first, field);
+        }
+        if (full || current.motor != last.motor) {
+            snprintf(field, sizeof(field), "\"motor\":\"%s\"", motorName(current.motor));
+            append(buffer, size, len, first, field);
+        }
+        if (full || current.windPulses != last.windPulses) {
+            snprintf(field, sizeof(field), "\"windPulses\":%lu", current.windPulses);
+            append(buffer, size, len, first, field);
+        }
+        if (full || current.windThreshold != last.windThreshold) {
+            snprintf(field, sizeof(field), "\"windThreshold\":%lu", current.windThreshold);
+            append(buffer, size, len, first, field);
+        }
+        if (full || current.travelTime != last.travelTime) {
+            snprintf(field, sizeof(field), "\"travelTime\":%lu", current.travelTime);
+            append(buffer, size, len, first, field);
+        }
+        if (full || current.calibrating != last.calibrating) {
+            append(buffer, size, len, first, current.calibrating ? "\"calibrating\":true" : "\"calibrating\":false");
+        }
+
+        if (first) {
+            buffer[0] = '\0';
+            return 0;
+        }
+        if (len + 2 > size) {
+            // Truncated - never send half an object
+            buffer[0] = '\0';
+            return 0;
+        }
+        buffer[len++] = '}';
+        buffer[len] = '\0';
+        return len;
+    }
+
+public:
+    static const char* motorName(AwningState state) {
+        switch (state) {
+            case AWNING_EXTENDING: return "Extending";
+            case AWNING_RETRACTING: return "Retracting";
+            default: return "Idle";
+        }
+    }
+
+    // A position as displayed, i.e. to one decimal
+    static float roundToDisplay(float value) {
+        return tenths(value) / 10.0f;
+    }
+
+    StatusDeltaEncoder()
+        : last()
+        , hasLast(false)
+        , lastPushTime(0) {}
+
+    // Rate limit for pushes: fast while the motor runs, slower when idle.
+    // A change of motor state is always due so start/stop show up at once.
+    bool isDue(unsigned long now, const StatusSnapshot& current,
+               unsigned long motionIntervalMs, unsigned long idleIntervalMs) const {
+        if (!hasLast || current.motor != last.motor || current.calibrating != last.calibrating) {
+            return true;
+        }
+        unsigned long interval = current.motor == AWNING_IDLE ? idleIntervalMs : motionIntervalMs;
+        return now - lastPushTime >= interval;
+    }
+
+    // Writes the changed fields into buffer and remembers them as sent.
+    // Returns the length, or 0 if nothing changed.
+    size_t encodeDelta(const StatusSnapshot& current, unsigned long now, char* buffer, size_t size) {
+        size_t len = encode(current, buffer, size, !hasLast);
+        lastPushTime = now;
+        if (len > 0) {
+            last = current;
+            hasLast = true;
+        }
+        return len;
+    }
+
+    // All fields, for a newly connected client. Does not affect the delta state.
+    size_t encodeFull(const StatusSnapshot& current, char* buffer, size_t size) const {
+        return encode(current, buffer, size, true);
+    }
+
+    void reset() {
+        hasLast = false;
+        lastPushTime = 0;
+    }
+
+    // True when both would be encoded identically
+    static bool sameAsEncoded(const StatusSnapshot& a, const StatusSnapshot& b) {
+        return tenths(a.position) == tenths(b.position) && tenths(a.target) == tenths(b.target) &&
+               a.motor == b.motor && a.windPulses == b.windPulses && a.windThreshold == b.windThreshold &&
+               a.travelTime == b.travelTime && a.calibrating == b.calibrating;
+    }
+};
+
+#endif // STATUS_DELTA_H
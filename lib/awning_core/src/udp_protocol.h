@@ -0,0 +1,152 @@
+#ifndef UDP_PROTOCOL_H
+#define UDP_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Compact binary control protocol over UDP. All fields big-endian.
+//
+// Request, 8 bytes:
+//   0-1  magic 'A' 'W'
+//   2    version (1)
+//   3    type (UdpRequestType)
+//   4-5  sequence number, chosen by the client
+//   6-7  argument: target position in tenths of a percent for SET_POSITION
+//
+// Response, 16 bytes:
+//   0-1  magic, 2 version, 3 request type | 0x80, 4-5 sequence echoed
+//   6    result (UdpResult)
+//   7    motor state (0 idle, 1 extending, 2 retracting)
+//   8-9  position, 10-11 target, both in tenths of a percent; the answer
+//        to an accepted SET_POSITION carries the target it set
+//   12-13 wind pulses per minute (saturated)
+//   14   flags (bit 0: calibrating)
+//   15   reserved
+
+const uint8_t UDP_MAGIC_0 = 'A';
+const uint8_t UDP_MAGIC_1 = 'W';
+const uint8_t UDP_PROTOCOL_VERSION = 1;
+const size_t UDP_REQUEST_SIZE = 8;
+const size_t UDP_RESPONSE_SIZE = 16;
+const uint8_t UDP_RESPONSE_FLAG = 0x80;
+const uint8_t UDP_FLAG_CALIBRATING = 0x01;
+
+enum UdpRequestType {
+    UDP_STATUS = 1,
+    UDP_SET_POSITION = 2,
+    UDP_STOP = 3
+};
+
+enum UdpResult {
+    UDP_OK = 0,
+    UDP_BAD_REQUEST = 1,
+    UDP_OUT_OF_RANGE = 2,
+    UDP_BUSY = 3
+};
+
+struct UdpRequest {
+    uint8_t type;
+    uint16_t sequence;
+    uint16_t argument;
+};
+
+struct UdpStatus {
+    uint8_t motorState;
+    uint16_t positionTenths;
+    uint16_t targetTenths;
+    uint16_t windPulses;
+    uint8_t flags;
+};
+
+// Returns false for anything that is not a well-formed version 1 request;
+// such packets are dropped without an answer
+inline bool parseUdpRequest(const uint8_t* data, size_t length, UdpRequest& request) {
+    if (length != UDP_REQUEST_SIZE || data[0] != UDP_MAGIC_0 || data[1] != UDP_MAGIC_1 ||
+        data[2] != UDP_PROTOCOL_VERSION) {
+        return false;
+    }
+    request.type = data[3];
+    request.sequence = static_cast<uint16_t>((data[4] << 8) | data[5]);
+    request.argument = static_cast<uint16_t>((data[6] << 8) | data[7]);
+    return true;
+}
+
+inline void encodeUdpResponse(const UdpRequest& request, uint8_t result, const UdpStatus& status,
+                              uint8_t out[UDP_RESPONSE_SIZE]) {
+    out[0] = UDP_MAGIC_0;
+    out[1] = UDP_MAGIC_1;
+    out[2] = UDP_PROTOCOL_VERSION;
+    out[3] = request.type | UDP_RESPONSE_FLAG;
+    out[4] = request.sequence >> 8;
+    out[5] = request.sequence & 0xFF;
+    out[6] = result;
+    out[7] = status.motorState;
+    out[8] = status.positionTenths >> 8;
+    out[9] = status.positionTenths & 0xFF;
+    out[10] = status.targetTenths >> 8;
+    out[11] = status.targetTenths & 0xFF;
+    out[12] = status.windPulses >> 8;
+    out[13] = status.windPulses & 0xFF;
+    out[14] = status.flags;
+    out[15] = 0;
+}
+
+// Remembers the last command sequence number and its result per client,
+// so a retransmitted command is answered again but not applied twice.
+class UdpSequenceTracker {
+public:
+    static constexpr size_t MAX_CLIENTS = 4;
+
+private:
+    struct Client {
+        uint32_t address;
+        uint16_t port;
+        uint16_t sequence;
+        uint8_t result;
+    };
+
+    Client clients[MAX_CLIENTS];
+    size_t clientCount;
+    size_t nextSlot;
+
+    Client* find(uint32_t address, uint16_t port) {
+        for (size_t i = 0; i < clientCount; i++) {
+            if (clients[i].address == address && clients[i].port == port) {
+                return &clients[i];
+            }
+        }
+        return nullptr;
+    }
+
+public:
+    UdpSequenceTracker() : clientCount(0), nextSlot(0) {}
+
+    // True if this is a repeat of the client's last command; result is
+    // then set to what the original got
+    bool isDuplicate(uint32_t address, uint16_t port, uint16_t sequence, uint8_t& result) {
+        Client* client = find(address, port);
+        if (client && client->sequence == sequence) {
+            result = client->result;
+            return true;
+        }
+        return false;
+    }
+
+    void record(uint32_t address, uint16_t port, uint16_t sequence, uint8_t result) {
+        Client* client = find(address, port);
+        if (!client) {
+            // Oldest client makes room
+            client = &clients[nextSlot];
+            nextSlot = (nextSlot + 1) % MAX_CLIENTS;
+            if (clientCount < MAX_CLIENTS) {
+                clientCount++;
+            }
+            client->address = address;
+            client->port = port;
+        }
+        client->sequence = sequence;
+        client->result = result;
+    }
+};
+
+#endif // UDP_PROTOCOL_H
@@ -0,0 +1,65 @@
+#ifndef WARM_STATE_H
+#define WARM_STATE_H
+
+#include <cstdint>
+#include "awning_types.h"
+
+// Motion state kept in RTC memory on every position tick, so a reset
+// (watchdog, exception, restart) does not lose the position. The motor
+// controller latches a start pulse and keeps running while the ESP
+// reboots, so a movement in progress is extrapolated over the reset.
+// Times are raw RTC clock ticks, the only clock that survives a reset.
+struct WarmState {
+    float position;               // At the last position tick
+    float target;
+    uint8_t state;                // AwningState
+    uint8_t reserved[3];
+    uint32_t movementStartTicks;  // When the current movement began
+    uint32_t positionTicks;       // When position was recorded
+};
+
+const unsigned long WARM_STATE_ELAPSED_UNKNOWN = 0xFFFFFFFFUL;
+
+struct WarmRecovery {
+    float position;
+    float target;
+    AwningState state;  // Still moving: resume tracking without a new pulse
+};
+
+// Where the awning is elapsedMs after the record was written. Pass
+// WARM_STATE_ELAPSED_UNKNOWN when the RTC clock did not survive the reset.
+inline WarmRecovery recoverWarmState(const WarmState& saved, unsigned long elapsedMs, unsigned long travelTimeMs) {
+    WarmRecovery result;
+    result.position = clamp(saved.position, MIN_POSITION, MAX_POSITION);
+    result.target = result.position;
+    result.state = AWNING_IDLE;
+
+    bool extending = saved.state == AWNING_EXTENDING;
+    if (!extending && saved.state != AWNING_RETRACTING) {
+        return result;
+    }
+    float limit = extending ? MAX_POSITION : MIN_POSITION;
+
+    // Nothing stopped the motor, so with no idea how long it ran it is at its end stop
+    if (elapsedMs == WARM_STATE_ELAPSED_UNKNOWN || travelTimeMs == 0) {
+        result.position = limit;
+        result.target = limit;
+        return result;
+    }
+
+    float change = static_cast<float>(elapsedMs) / static_cast<float>(travelTimeMs) * 100.0f;
+    result.position = clamp(extending ? saved.position + change : saved.position - change, MIN_POSITION, MAX_POSITION);
+    if (result.position == limit) {
+        result.target = limit;
+        return result;
+    }
+
+    // Within or past the target nobody sent the stop pulse; the motor runs on to its end stop
+    bool targetPassed = extending ? result.position > saved.target - POSITION_TOLERANCE
+                                  : result.position < saved.target + POSITION_TOLERANCE;
+    result.target = targetPassed ? limit : saved.target;
+    result.state = extending ? AWNING_EXTENDING : AWNING_RETRACTING;
+    return result;
+}
+
+#endif // WARM_STATE_H
@@ -0,0 +1,135 @@
+#ifndef WIFI_SCAN_CACHE_H
+#define WIFI_SCAN_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// Platform-independent store for the result of a WiFi scan. Networks are
+// kept strongest first with one entry per SSID (mesh and multi-AP setups
+// report the same name several times); the weakest are dropped when more
+// than N are seen. The JSON is written from the cache into any writer with
+// write(char, sink) and write(const char*, sink), so it can be streamed in
+// chunks without building a String.
+template<size_t N>
+class WifiScanCache {
+public:
+    static constexpr size_t MAX_SSID_LENGTH = 32;
+
+    struct Network {
+        char ssid[MAX_SSID_LENGTH + 1];
+        int8_t rssi;
+    };
+
+private:
+    Network networks[N];
+    size_t count;
+    unsigned long completedAt;
+    bool valid;
+
+public:
+    WifiScanCache() : count(0), completedAt(0), valid(false) {}
+
+    // Starts collecting a new result; the old one is gone
+    void clear() {
+        count = 0;
+        valid = false;
+    }
+
+    void add(const char* ssid, int rssi) {
+        if (!ssid || ssid[0] == '\0') {
+            return;  // Hidden network
+        }
+        int8_t level = rssi < -128 ? -128 : (rssi > 0 ? 0 : (int8_t)rssi);
+
+        size_t i = 0;
+        for (; i < count; i++) {
+            if (strncmp(networks[i].ssid, ssid, MAX_SSID_LENGTH) == 0) {
+                break;
+            }
+        }
+        if (i < count) {
+            if (level <= networks[i].rssi) {
+                return;
+            }
+            remove(i);
+        }
+
+        // Insertion point keeps the list sorted strongest first
+        size_t position = 0;
+        while (position < count && networks[position].rssi >= level) {
+            position++;
+        }
+        if (position >= N) {
+            return;
+        }
+        size_t last = count < N ? count : N - 1;
+        for (size_t j = last; j > position; j--) {
+            networks[j] = networks[j - 1];
+        }
+        strncpy(networks[position].ssid, ssid, MAX_SSID_LENGTH);
+        networks[position].ssid[MAX_SSID_LENGTH] = '\0';
+        networks[position].rssi = level;
+        if (count < N) {
+            count++;
+        }
+    }
+
+    void complete(unsigned long now) {
+        completedAt = now;
+        valid = true;
+    }
+
+    bool isFresh(unsigned long now, unsigned long ttlMs) const {
+        return valid && now - completedAt < ttlMs;
+    }
+
+    bool isValid() const { return valid; }
+    size_t size() const { return count; }
+    const Network& get(size_t i) const { return networks[i]; }
+    unsigned long getAgeMs(unsigned long now) const { return now - completedAt; }
+
+    // [{"ssid":"...","rssi":-60},...]
+    template<typename Writer, typename Sink>
+    void writeJson(Writer& writer, Sink& sink) const {
+        writer.write('[', sink);
+        for (size_t i = 0; i < count; i++) {
+            char rssi[8];
+            snprintf(rssi, sizeof(rssi), "%d", networks[i].rssi);
+            writer.write(i > 0 ? ",{\"ssid\":\"" : "{\"ssid\":\"", sink);
+            writeEscaped(networks[i].ssid, writer, sink);
+            writer.write("\",\"rssi\":", sink);
+            writer.write(rssi, sink);
+            writer.write('}', sink);
+        }
+        writer.write(']', sink);
+    }
+
+private:
+    void remove(size_t i) {
+        for (; i + 1 < count; i++) {
+            networks[i] = networks[i + 1];
+        }
+        count--;
+    }
+
+    template<typename Writer, typename Sink>
+    static void writeEscaped(const char* text, Writer& writer, Sink& sink) {
+        for (; *text; text++) {
+            unsigned char c = (unsigned char)*text;
+            if (c == '"' || c == '\\') {
+                writer.write('\\', sink);
+                writer.write((char)c, sink);
+            } else if (c < 0x20) {
+                char escaped[7];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                writer.write(escaped, sink);
+            } else {
+                writer.write((char)c, sink);
+            }
+        }
+    }
+};
+
+#endif // WIFI_SCAN_CACHE_H
@@ -0,0 +1,28 @@
+#!/bin/sh
+# Generates a test CA and server certificate for the TLS broker.
+# Usage: ./mosquitto/gen-certs.sh [broker hostname or IP]
+set -e
+
+HOST="${1:-localhost}"
+DIR="$(dirname "$0")/certs"
+mkdir -p "$DIR"
+cd "$DIR"
+
+# EC keys keep the ESP8266 handshake much cheaper than RSA
+openssl ecparam -name prime256v1 -genkey -noout -out ca.key
+openssl req -new -x509 -days 3650 -key ca.key -out ca.crt -subj "/CN=Sonnensegel Test CA"
+
+openssl ecparam -name prime256v1 -genkey -noout -out server.key
+openssl req -new -key server.key -out server.csr -subj "/CN=$HOST"
+case "$HOST" in
+    *[!0-9.]*) printf "subjectAltName=DNS:%s\n" "$HOST" > san.ext ;;
+    *) printf "subjectAltName=IP:%s\n" "$HOST" > san.ext ;;
+esac
+openssl x509 -req -days 3650 -in server.csr -CA ca.crt -CAkey ca.key -CAcreateserial \
+    -out server.crt -extfile san.ext
+rm -f server.csr san.ext
+chmod 644 server.key
+
+echo
+echo "Fingerprint for the system configuration page:"
+openssl x509 -noout -fingerprint -sha1 -in server.crt | cut -d= -f2
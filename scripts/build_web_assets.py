@@ -0,0 +1,101 @@
+"""Minify and gzip the pages in web/ into include/web_assets.h.
+
+Runs automatically before every PlatformIO build (extra_scripts in
+platformio.ini) and can be run by hand for the Arduino IDE:
+
+    python3 scripts/build_web_assets.py
+
+Each web/<name>.<ext> becomes a PROGMEM byte array <NAME>_<EXT>_GZ with its
+length and a strong ETag derived from the compressed bytes. The output is
+deterministic, so the header only changes when a page does.
+"""
+
+import gzip
+import hashlib
+import os
+import re
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO/SCons
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SOURCE_DIR = os.path.join(PROJECT_DIR, "web")
+OUTPUT_FILE = os.path.join(PROJECT_DIR, "include", "web_assets.h")
+
+CONTENT_TYPES = {
+    ".html": "text/html",
+    ".css": "text/css",
+    ".js": "application/javascript",
+}
+
+
+def minify(text):
+    """Conservative minification: gzip does the heavy lifting.
+
+    Line breaks are kept so inline JavaScript never depends on automatic
+    semicolon insertion across joined lines.
+    """
+    text = re.sub(r"<!--.*?-->", "", text, flags=re.DOTALL)
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.DOTALL)
+    lines = []
+    for line in text.splitlines():
+        line = line.strip()
+        if not line or line.startswith("//"):
+            continue
+        lines.append(line)
+    return "\n".join(lines) + "\n"
+
+
+def symbol_for(filename):
+    return re.sub(r"[^A-Za-z0-9]", "_", filename).upper()
+
+
+def render_asset(filename, source):
+    compressed = gzip.compress(minify(source).encode("utf-8"), compresslevel=9, mtime=0)
+    etag = hashlib.sha1(compressed).hexdigest()[:16]
+    symbol = symbol_for(filename)
+    content_type = CONTENT_TYPES[os.path.splitext(filename)[1]]
+
+    rows = []
+    for i in range(0, len(compressed), 16):
+        rows.append("    " + ", ".join("0x%02x" % b for b in compressed[i:i + 16]) + ",")
+
+    return (
+        "// %s: %d bytes source, %d bytes gzipped\n" % (filename, len(source.encode("utf-8")), len(compressed))
+        + "const uint8_t %s_GZ[] PROGMEM = {\n%s\n};\n" % (symbol, "\n".join(rows))
+        + "const size_t %s_GZ_LEN = %d;\n" % (symbol, len(compressed))
+        + "const char %s_ETAG[] = \"\\\"%s\\\"\";\n" % (symbol, etag)
+        + "const char %s_TYPE[] = \"%s\";\n" % (symbol, content_type)
+    )
+
+
+def build():
+    assets = []
+    for filename in sorted(os.listdir(SOURCE_DIR)):
+        if os.path.splitext(filename)[1] not in CONTENT_TYPES:
+            continue
+        with open(os.path.join(SOURCE_DIR, filename), encoding="utf-8") as f:
+            assets.append(render_asset(filename, f.read()))
+
+    header = (
+        "// Generated by scripts/build_web_assets.py from web/ - do not edit\n"
+        "#ifndef WEB_ASSETS_H\n"
+        "#define WEB_ASSETS_H\n\n"
+        "#include <Arduino.h>\n\n"
+        + "\n".join(assets)
+        + "\n#endif // WEB_ASSETS_H\n"
+    )
+
+    # Leave the file untouched when nothing changed to avoid needless rebuilds
+    if os.path.exists(OUTPUT_FILE):
+        with open(OUTPUT_FILE, encoding="utf-8") as f:
+            if f.read() == header:
+                return
+    with open(OUTPUT_FILE, "w", encoding="utf-8") as f:
+        f.write(header)
+    print("Web assets: wrote %s" % os.path.relpath(OUTPUT_FILE, PROJECT_DIR))
+
+
+build()
@@ -0,0 +1,115 @@
+"""Measure how HTTP load affects the controller's main loop.
+
+Reads /diag at idle, then fetches the web pages and /status from several
+threads while sampling /diag, and prints loop timing for both phases:
+
+    python3 scripts/http_load_test.py sonnensegel.local --threads 4 --duration 30
+
+Only uses the Python standard library.
+"""
+
+import argparse
+import json
+import threading
+import time
+import urllib.request
+
+PATHS = ["/", "/status", "/system-config"]
+
+
+def get(host, path, timeout=10):
+    request = urllib.request.Request("http://%s%s" % (host, path), headers={"Accept-Encoding": "gzip"})
+    with urllib.request.urlopen(request, timeout=timeout) as response:
+        return response.read()
+
+
+def diag(host, reset=False):
+    return json.loads(get(host, "/diag?reset=1" if reset else "/diag"))
+
+
+def sample(host, seconds):
+    """Loop timing over a window of the given length."""
+    diag(host, reset=True)
+    time.sleep(seconds)
+    return diag(host, reset=True)
+
+
+def worker(host, stop, results, lock):
+    i = 0
+    while not stop.is_set():
+        path = PATHS[i % len(PATHS)]
+        i += 1
+        start = time.monotonic()
+        try:
+            get(host, path)
+            ok = True
+        except OSError:
+            ok = False
+        elapsed = (time.monotonic() - start) * 1000
+        with lock:
+            results.append((path, ok, elapsed))
+
+
+def percentile(values, p):
+    if not values:
+        return 0.0
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * p / 100))]
+
+
+def print_loop(label, d):
+    print("%-6s loop avg %5d us  max %7d us  (%d iterations, %d commands rejected)"
+          % (label, d["loopAvgUs"], d["loopMaxUs"], d["loopCount"], d["commandsRejected"]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("host")
+    parser.add_argument("--threads", type=int, default=4)
+    parser.add_argument("--duration", type=float, default=30.0, help="Seconds of load")
+    parser.add_argument("--idle", type=float, default=5.0, help="Seconds of idle baseline")
+    args = parser.parse_args()
+
+    idle = sample(args.host, args.idle)
+
+    stop = threading.Event()
+    lock = threading.Lock()
+    results = []
+    threads = [threading.Thread(target=worker, args=(args.host, stop, results, lock), daemon=True)
+               for _ in range(args.threads)]
+    diag(args.host, reset=True)
+    for thread in threads:
+        thread.start()
+
+    # Sample in windows so a single bad stretch is visible as the max
+    load_max = 0
+    load_avg = []
+    deadline = time.monotonic() + args.duration
+    while time.monotonic() < deadline:
+        time.sleep(min(5.0, max(0.0, deadline - time.monotonic())))
+        try:
+            d = diag(args.host, reset=True)
+        except OSError:
+            continue
+        load_max = max(load_max, d["loopMaxUs"])
+        load_avg.append(d["loopAvgUs"])
+        last = d
+    stop.set()
+    for thread in threads:
+        thread.join()
+
+    print_loop("idle", idle)
+    if load_avg:
+        last["loopAvgUs"] = sum(load_avg) // len(load_avg)
+        last["loopMaxUs"] = load_max
+        print_loop("load", last)
+
+    for path in PATHS:
+        times = [ms for p, ok, ms in results if p == path and ok]
+        failed = sum(1 for p, ok, _ in results if p == path and not ok)
+        print("%-15s %5d ok %3d failed  p50 %6.1f ms  p95 %6.1f ms"
+              % (path, len(times), failed, percentile(times, 50), percentile(times, 95)))
+
+
+if __name__ == "__main__":
+    main()
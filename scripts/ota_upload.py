@@ -0,0 +1,109 @@
+"""Upload a firmware image to the controller over HTTP.
+
+    AWNING_OTA_PASSWORD=... python3 scripts/ota_upload.py sonnensegel.local .pio/build/esp12e/firmware.bin
+
+Sends the image with its MD5 to POST /update, authenticated with HTTP
+digest auth against the password the firmware was built with, then prints
+the upload throughput and the longest gap between safety task runs that the
+device measured while writing it. Only uses the Python standard library.
+"""
+
+import argparse
+import hashlib
+import json
+import os
+import re
+import urllib.error
+import urllib.request
+
+USERNAME = "admin"
+
+
+def read_json(response):
+    try:
+        return json.loads(response.read() or b"{}")
+    except ValueError:
+        return {}
+
+
+def fetch_challenge(url, timeout):
+    """Empty POST, so the device answers with a digest challenge before the image is sent."""
+    request = urllib.request.Request(url, data=b"", method="POST")
+    try:
+        with urllib.request.urlopen(request, timeout=timeout) as response:
+            return None, response.status, read_json(response)
+    except urllib.error.HTTPError as e:
+        if e.code != 401:
+            return None, e.code, read_json(e)
+        header = e.headers.get("WWW-Authenticate", "")
+        return dict(re.findall(r'(\w+)="([^"]*)"', header)), e.code, {}
+
+
+def digest_header(challenge, password, path):
+    md5 = lambda text: hashlib.md5(text.encode()).hexdigest()
+    cnonce = os.urandom(8).hex()
+    ha1 = md5("%s:%s:%s" % (USERNAME, challenge["realm"], password))
+    ha2 = md5("POST:%s" % path)
+    response = md5("%s:%s:00000001:%s:auth:%s" % (ha1, challenge["nonce"], cnonce, ha2))
+    return ('Digest username="%s", realm="%s", nonce="%s", uri="%s", qop=auth, nc=00000001, '
+            'cnonce="%s", response="%s", opaque="%s"'
+            % (USERNAME, challenge["realm"], challenge["nonce"], path, cnonce, response,
+               challenge.get("opaque", "")))
+
+
+def upload(host, path, password, timeout=120):
+    with open(path, "rb") as f:
+        image = f.read()
+    md5 = hashlib.md5(image).hexdigest()
+    boundary = "----awning-ota-" + md5[:16]
+    body = (
+        ("--%s\r\nContent-Disposition: form-data; name=\"firmware\"; filename=\"%s\"\r\n"
+         "Content-Type: application/octet-stream\r\n\r\n" % (boundary, os.path.basename(path))).encode()
+        + image
+        + ("\r\n--%s--\r\n" % boundary).encode()
+    )
+    target = "/update?md5=%s&size=%d" % (md5, len(image))
+    url = "http://%s%s" % (host, target)
+
+    challenge, status, result = fetch_challenge(url, timeout)
+    if challenge is None:
+        return status, result
+    request = urllib.request.Request(
+        url,
+        data=body,
+        headers={
+            "Content-Type": "multipart/form-data; boundary=%s" % boundary,
+            "Authorization": digest_header(challenge, password, target),
+        },
+    )
+    try:
+        with urllib.request.urlopen(request, timeout=timeout) as response:
+            return response.status, read_json(response)
+    except urllib.error.HTTPError as e:
+        if e.code == 401:
+            return e.code, {"error": "wrong_password"}
+        return e.code, read_json(e)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("host")
+    parser.add_argument("image")
+    parser.add_argument("--password", default=os.environ.get("AWNING_OTA_PASSWORD", ""),
+                        help="OTA password (default: $AWNING_OTA_PASSWORD)")
+    args = parser.parse_args()
+    if not args.password:
+        parser.error("no OTA password; pass --password or set AWNING_OTA_PASSWORD")
+
+    status, result = upload(args.host, args.image, args.password)
+    if status != 200:
+        print("Update failed (%d): %s" % (status, result.get("error", "unknown")))
+        raise SystemExit(1)
+    print("Uploaded %d bytes in %d ms (%.1f KiB/s)" % (result["bytes"], result["ms"], result["throughputBps"] / 1024.0))
+    print("Safety tasks: max gap %.1f ms, average %.1f ms"
+          % (result["safetyMaxGapUs"] / 1000.0, result["safetyAvgGapUs"] / 1000.0))
+    print("The controller restarts once the motor is idle")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,57 @@
+"""Query or command the controller over its UDP control endpoint.
+
+    python3 scripts/udp_control.py sonnensegel.local status
+    python3 scripts/udp_control.py sonnensegel.local position 42.5
+    python3 scripts/udp_control.py sonnensegel.local stop
+
+Requests are retried with the same sequence number, so a command whose
+answer was lost is not applied twice. Only uses the Python standard library.
+"""
+
+import argparse
+import random
+import socket
+import struct
+
+PORT = 4210
+TYPES = {"status": 1, "position": 2, "stop": 3}
+RESULTS = ["ok", "bad_request", "out_of_range", "busy"]
+MOTOR = ["idle", "extending", "retracting"]
+
+
+def request(host, kind, position=0.0, retries=3, timeout=0.5):
+    sequence = random.randrange(0x10000)
+    packet = struct.pack(">2sBBHH", b"AW", 1, TYPES[kind], sequence, int(round(position * 10)))
+    with socket.socket(socket.AF_INET, socket.SOCK_DGRAM) as sock:
+        sock.settimeout(timeout)
+        for _ in range(retries):
+            sock.sendto(packet, (host, PORT))
+            try:
+                data, _ = sock.recvfrom(64)
+            except socket.timeout:
+                continue
+            magic, _, _, seq, result, motor, pos, target, wind, flags, _ = struct.unpack(">2sBBHBBHHHBB", data)
+            if magic == b"AW" and seq == sequence:
+                return {
+                    "result": RESULTS[result] if result < len(RESULTS) else result,
+                    "motor": MOTOR[motor] if motor < len(MOTOR) else motor,
+                    "position": pos / 10.0,
+                    "target": target / 10.0,
+                    "windPulses": wind,
+                    "calibrating": bool(flags & 1),
+                }
+    raise TimeoutError("no answer from %s:%d" % (host, PORT))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("host")
+    parser.add_argument("command", choices=sorted(TYPES))
+    parser.add_argument("position", nargs="?", type=float, default=0.0)
+    args = parser.parse_args()
+    host = socket.gethostbyname(args.host)
+    print(request(host, args.command, args.position))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,101 @@
+#include "broker_probe.h"
+
+BrokerProbe::BrokerProbe() : state(IDLE), pcb(nullptr), port(0), startedAt(0) {}
+
+void BrokerProbe::start(const char* host, uint16_t prt, unsigned long now) {
+    cancel();
+    port = prt;
+    startedAt = now;
+    
+    ip_addr_t address;
+    if (ipaddr_aton(host, &address)) {
+        connectTo(&address);
+        return;
+    }
+    
+    state = RESOLVING;
+    err_t err = dns_gethostbyname(host, &address, onResolved, this);
+    if (err == ERR_OK) {
+        connectTo(&address);  // Answered from the DNS cache
+    } else if (err != ERR_INPROGRESS) {
+        state = UNREACHABLE;
+    }
+}
+
+void BrokerProbe::connectTo(const ip_addr_t* address) {
+    pcb = tcp_new();
+    if (!pcb) {
+        state = UNREACHABLE;
+        return;
+    }
+    
+    state = CONNECTING;
+    tcp_arg(pcb, this);
+    tcp_err(pcb, onError);
+    if (tcp_connect(pcb, address, port, onConnected) != ERR_OK) {
+        release();
+        state = UNREACHABLE;
+    }
+}
+
+// Drops the connection attempt without waiting for a FIN exchange
+void BrokerProbe::release() {
+    if (pcb) {
+        tcp_arg(pcb, nullptr);
+        tcp_err(pcb, nullptr);
+        tcp_abort(pcb);
+        pcb = nullptr;
+    }
+}
+
+void BrokerProbe::onResolved(const char* name, const ip_addr_t* address, void* arg) {
+    BrokerProbe* probe = static_cast<BrokerProbe*>(arg);
+    // A lookup that outlived a cancelled or timed out probe is ignored
+    if (probe->state != RESOLVING) {
+        return;
+    }
+    if (!address) {
+        probe->state = UNREACHABLE;
+        return;
+    }
+    probe->connectTo(address);
+}
+
+err_t BrokerProbe::onConnected(void* arg, struct tcp_pcb* connected, err_t err) {
+    BrokerProbe* probe = static_cast<BrokerProbe*>(arg);
+    probe->release();
+    probe->state = REACHABLE;
+    // The pcb was aborted above, which lwIP must be told
+    return ERR_ABRT;
+}
+
+void BrokerProbe::onError(void* arg, err_t err) {
+    BrokerProbe* probe = static_cast<BrokerProbe*>(arg);
+    // lwIP has already freed the pcb
+    probe->pcb = nullptr;
+    probe->state = UNREACHABLE;
+}
+
+BrokerProbeResult BrokerProbe::poll(unsigned long now, unsigned long timeoutMs) {
+    switch (state) {
+        case IDLE:
+            return PROBE_IDLE;
+        case REACHABLE:
+            state = IDLE;
+            return PROBE_REACHABLE;
+        case UNREACHABLE:
+            state = IDLE;
+            return PROBE_UNREACHABLE;
+        default:
+            if (now - startedAt < timeoutMs) {
+                return PROBE_PENDING;
+            }
+            cancel();
+            return PROBE_UNREACHABLE;
+    }
+}
+
+void BrokerProbe::cancel() {
+    release();
+    state = IDLE;
+}
@@ -2,7 +2,8 @@
 
 ButtonHandler::ButtonHandler(uint8_t buttonPin) 
     : pin(buttonPin), lastState(HIGH), currentState(HIGH), 
-      lastDebounceTime(0), pressStartTime(0), longPressHandled(false), shortPressHandled(false) {
+      lastDebounceTime(0), pressStartTime(0), longPressHandled(false), shortPressHandled(false),
+      pressEdgeTime(0), pressEdgePending(false) {
 }
 
 void ButtonHandler::begin() {
@@ -18,6 +19,9 @@ void ButtonHandler::updatePressTime() {
         pressStartTime = millis();
         longPressHandled = false;
         shortPressHandled = false;
+        // The reading has been stable since lastDebounceTime
+        pressEdgeTime = lastDebounceTime;
+        pressEdgePending = true;
     }
 }
 
@@ -65,4 +69,13 @@ ButtonAction ButtonHandler::update() {
     
     lastState = reading;
     return checkPressType();
-}
\ No newline at end of file
+}
+
+bool ButtonHandler::takePressEdge(unsigned long& edgeTime) {
+    if (!pressEdgePending) {
+        return false;
+    }
+    pressEdgePending = false;
+    edgeTime = pressEdgeTime;
+    return true;
+}
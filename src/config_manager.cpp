@@ -3,9 +3,38 @@
 #include <EEPROM.h>
 #include <string.h>
 
-const uint32_t CONFIG_MAGIC = 0xABC12301;
+const uint32_t CONFIG_MAGIC = 0xABC12306;
+const uint32_t CONFIG_MAGIC_V1 = 0xABC12301;
 const int CONFIG_EEPROM_ADDR = 0;
 
+// Layout written by the first firmware release, migrated on load
+struct MQTTConfigV1 {
+    bool enabled;
+    char server[64];
+    uint16_t port;
+    char username[32];
+    char password[64];
+    char clientId[32];
+    char baseTopic[64];
+};
+
+struct SystemConfigV1 {
+    uint32_t magic;
+    WiFiConfig wifi;
+    MQTTConfigV1 mqtt;
+    AwningConfig awning;
+    uint32_t checksum;
+};
+
+static uint32_t sumBytes(const void* data, size_t size) {
+    uint32_t checksum = 0;
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; i++) {
+        checksum += bytes[i];
+    }
+    return checksum;
+}
+
 ConfigManager::ConfigManager() : configValid(false) {
     setDefaults();
 }
@@ -31,6 +60,12 @@ void ConfigManager::setDefaults() {
     memset(config.mqtt.password, 0, sizeof(config.mqtt.password));
     strncpy(config.mqtt.clientId, "sonnensegel", sizeof(config.mqtt.clientId) - 1);
     strncpy(config.mqtt.baseTopic, "home/sonnensegel", sizeof(config.mqtt.baseTopic) - 1);
+    config.mqtt.persistentSession = false;
+    config.mqtt.tlsEnabled = false;
+    memset(config.mqtt.tlsFingerprint, 0, sizeof(config.mqtt.tlsFingerprint));
+    memset(config.mqtt.secondaryServer, 0, sizeof(config.mqtt.secondaryServer));
+    config.mqtt.secondaryPort = 1883;
+    config.mqtt.jsonState = false;
     
     // Awning defaults
     config.awning.travelTimeMs = DEFAULT_TRAVEL_TIME_MS;
@@ -38,23 +73,46 @@ void ConfigManager::setDefaults() {
     config.awning.currentPosition = 0.0;
     config.awning.targetPosition = 0.0;
     
+    memset(&config.fastConnect, 0, sizeof(config.fastConnect));
+    
     config.checksum = calculateChecksum(config);
 }
 
 uint32_t ConfigManager::calculateChecksum(const SystemConfig& cfg) const {
-    uint32_t checksum = 0;
-    const uint8_t* data = (const uint8_t*)&cfg;
-    size_t size = sizeof(SystemConfig) - sizeof(uint32_t); // Exclude checksum field
+    return sumBytes(&cfg, sizeof(SystemConfig) - sizeof(uint32_t)); // Exclude checksum field
+}
+
+bool ConfigManager::migrateFromV1() {
+    SystemConfigV1 old;
+    EEPROM.get(CONFIG_EEPROM_ADDR, old);
     
-    for (size_t i = 0; i < size; i++) {
-        checksum += data[i];
+    if (old.magic != CONFIG_MAGIC_V1 ||
+        old.checksum != sumBytes(&old, sizeof(SystemConfigV1) - sizeof(uint32_t))) {
+        return false;
     }
-    return checksum;
+    
+    setDefaults();
+    config.wifi = old.wifi;
+    config.mqtt.enabled = old.mqtt.enabled;
+    memcpy(config.mqtt.server, old.mqtt.server, sizeof(config.mqtt.server));
+    config.mqtt.port = old.mqtt.port;
+    memcpy(config.mqtt.username, old.mqtt.username, sizeof(config.mqtt.username));
+    memcpy(config.mqtt.password, old.mqtt.password, sizeof(config.mqtt.password));
+    memcpy(config.mqtt.clientId, old.mqtt.clientId, sizeof(config.mqtt.clientId));
+    memcpy(config.mqtt.baseTopic, old.mqtt.baseTopic, sizeof(config.mqtt.baseTopic));
+    config.awning = old.awning;
+    
+    Serial.println("Config: Migrated from v1 layout");
+    return save();
 }
 
 bool ConfigManager::load() {
     EEPROM.get(CONFIG_EEPROM_ADDR, config);
     
+    if (config.magic == CONFIG_MAGIC_V1 && migrateFromV1()) {
+        return true;
+    }
+    
     if (config.magic != CONFIG_MAGIC) {
         Serial.println("Config: Invalid magic, using defaults");
         setDefaults();
@@ -108,10 +166,34 @@ void ConfigManager::setHostname(const char* hostname) {
     config.wifi.hostname[sizeof(config.wifi.hostname) - 1] = '\0';
 }
 
+void ConfigManager::setWiFiFastConnect(const WiFiFastConnectConfig& fastConnect) {
+    config.fastConnect = fastConnect;
+}
+
 void ConfigManager::setMQTTEnabled(bool enabled) {
     config.mqtt.enabled = enabled;
 }
 
+void ConfigManager::setMQTTPersistentSession(bool persistent) {
+    config.mqtt.persistentSession = persistent;
+}
+
+void ConfigManager::setMQTTTls(bool enabled, const char* fingerprint) {
+    config.mqtt.tlsEnabled = enabled;
+    strncpy(config.mqtt.tlsFingerprint, fingerprint, sizeof(config.mqtt.tlsFingerprint) - 1);
+    config.mqtt.tlsFingerprint[sizeof(config.mqtt.tlsFingerprint) - 1] = '\0';
+}
+
+void ConfigManager::setMQTTSecondaryBroker(const char* server, uint16_t port) {
+    strncpy(config.mqtt.secondaryServer, server, sizeof(config.mqtt.secondaryServer) - 1);
+    config.mqtt.secondaryServer[sizeof(config.mqtt.secondaryServer) - 1] = '\0';
+    config.mqtt.secondaryPort = port > 0 ? port : 1883;
+}
+
+void ConfigManager::setMQTTJsonState(bool enabled) {
+    config.mqtt.jsonState = enabled;
+}
+
 void ConfigManager::setMQTTConfig(const char* server, uint16_t port, const char* username, 
                                   const char* password, const char* clientId, const char* baseTopic) {
     strncpy(config.mqtt.server, server, sizeof(config.mqtt.server) - 1);
@@ -0,0 +1,67 @@
+#include "html_stream.h"
+
+namespace {
+
+struct TextField {
+    const char* name;
+    const char* (ConfigManager::*get)() const;
+};
+
+struct PortField {
+    const char* name;
+    uint16_t (ConfigManager::*get)() const;
+};
+
+struct CheckboxField {
+    const char* name;
+    bool (ConfigManager::*get)() const;
+};
+
+const TextField TEXT_FIELDS[] = {
+    {"wifi_ssid", &ConfigManager::getWiFiSSID},
+    {"hostname", &ConfigManager::getHostname},
+    {"mqtt_server", &ConfigManager::getMQTTServer},
+    {"mqtt_secondary_server", &ConfigManager::getMQTTSecondaryServer},
+    {"mqtt_username", &ConfigManager::getMQTTUsername},
+    {"mqtt_client_id", &ConfigManager::getMQTTClientId},
+    {"mqtt_base_topic", &ConfigManager::getMQTTBaseTopic},
+    {"mqtt_tls_fingerprint", &ConfigManager::getMQTTTlsFingerprint},
+};
+
+const PortField PORT_FIELDS[] = {
+    {"mqtt_port", &ConfigManager::getMQTTPort},
+    {"mqtt_secondary_port", &ConfigManager::getMQTTSecondaryPort},
+};
+
+const CheckboxField CHECKBOX_FIELDS[] = {
+    {"mqtt_enabled", &ConfigManager::isMQTTEnabled},
+    {"mqtt_persistent", &ConfigManager::isMQTTPersistentSession},
+    {"mqtt_tls", &ConfigManager::isMQTTTlsEnabled},
+    {"mqtt_json_state", &ConfigManager::isMQTTJsonState},
+};
+
+}  // namespace
+
+const char* resolveConfigPlaceholder(const ConfigManager& config, const char* name, 
+                                     char* scratch, size_t scratchSize) {
+    for (const TextField& field : TEXT_FIELDS) {
+        if (strcmp(name, field.name) == 0) {
+            return (config.*field.get)();
+        }
+    }
+    
+    for (const PortField& field : PORT_FIELDS) {
+        if (strcmp(name, field.name) == 0) {
+            snprintf(scratch, scratchSize, "%u", (config.*field.get)());
+            return scratch;
+        }
+    }
+    
+    for (const CheckboxField& field : CHECKBOX_FIELDS) {
+        if (strcmp(name, field.name) == 0) {
+            return (config.*field.get)() ? "checked" : "";
+        }
+    }
+    
+    return nullptr;
+}
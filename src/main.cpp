@@ -12,6 +12,19 @@
 #include "mqtt_handler.h"
 #include "storage.h"
 #include "web_interface.h"
+#include "control_command_queue.h"
+#include "loop_stats.h"
+#include "loop_tasks.h"
+#include "boot_stages.h"
+#include "calibration_session.h"
+#include "udp_control.h"
+#include "warm_state.h"
+#include "status_delta.h"
+#include "rtc_record.h"
+
+extern "C" {
+#include <user_interface.h>
+}
 
 // Global objects
 ConfigManager configManager;
@@ -26,15 +39,27 @@ WindSensor windSensor(&windPulseCount);
 MqttHandler mqtt;
 Storage storage;
 WebInterface webInterface(&configManager);
+ControlCommandQueue controlCommands;
+LoopStats loopStats;
+LoopStats taskStats[LOOP_TASK_COUNT];
+BootTimeline<BOOT_STAGE_COUNT> bootTimeline;
+float travelSinceEndStop = 0.0;  // Dead-reckoned travel, re-anchored at 0% and 100%
+CalibrationSession calibration;
+UdpControl udpControl;
+RtcRecord<WarmState> warmState;
 
 // Initialize configuration
 void initializeConfig() {
     if (!configManager.begin()) {
         Serial.println("Config: Using defaults");
     }
-    
-    // Initialize WiFi manager
-    wifiManager.begin();
+}
+
+// Records a startup stage in microseconds since reset; returns true the
+// first time. Stages past the 32-bit range (71 minutes) show that limit.
+bool markBootStage(BootStage stage) {
+    uint64_t now = micros64();
+    return bootTimeline.mark(stage, now > 0xFFFFFFFFULL ? 0xFFFFFFFFUL : (uint32_t)now);
 }
 
 // Wind sensor ISR
@@ -51,6 +76,12 @@ void IRAM_ATTR windSensorISR() {
 
 // Helper function to set new target via the state machine
 void setTargetPosition(float targetPosition, const char* source = "") {
+    // Any other command ends a calibration, its runs would be mistimed
+    if (calibration.isActive() && strcmp(source, "Calibration") != 0) {
+        calibration.cancel();
+        Serial.println("Calibration: Cancelled by another command");
+    }
+
     awning.setTarget(targetPosition);
 
     if (strlen(source) > 0) {
@@ -61,25 +92,93 @@ void setTargetPosition(float targetPosition, const char* source = "") {
     }
 }
 
-// Initialize all components
-void initializeComponents() {
+// Initialize buttons and the wind sensor; the relays come up before this
+void initializeInputs() {
     extendButton.begin();
     retractButton.begin();
-    motor.begin();
     windSensor.begin();
     storage.begin();
     
     attachInterrupt(digitalPinToInterrupt(WIND_SENSOR_PIN), windSensorISR, FALLING);
 }
 
+// RTC clock ticks to milliseconds; the calibration is microseconds per tick in Q12
+unsigned long rtcTicksToMs(uint32_t ticks) {
+    return (unsigned long)((((uint64_t)ticks * system_rtc_clock_cali_proc()) >> 12) / 1000);
+}
+
+// Takes the position from RTC memory after a reset, including a movement
+// the motor kept making while this controller rebooted. Returns false on a
+// cold boot, when RTC memory holds nothing valid.
+bool restoreWarmState() {
+    if (!ESP.rtcUserMemoryRead(RTC_WARM_STATE_BLOCK, (uint32_t*)&warmState, sizeof(warmState)) ||
+        !warmState.isValid(RTC_WARM_STATE_MAGIC)) {
+        return false;
+    }
+
+    // Power-on and external resets restart the RTC clock too
+    uint32_t reason = ESP.getResetInfoPtr()->reason;
+    bool clockKept = reason != REASON_DEFAULT_RST && reason != REASON_EXT_SYS_RST;
+    uint32_t now = system_get_rtc_time();
+    const WarmState& saved = warmState.payload;
+    unsigned long elapsed = clockKept ? rtcTicksToMs(now - saved.positionTicks) : WARM_STATE_ELAPSED_UNKNOWN;
+
+    WarmRecovery recovery = recoverWarmState(saved, elapsed, positionTracker.getTravelTime());
+    awning.setCurrentPosition(recovery.position);
+    if (recovery.state != AWNING_IDLE) {
+        awning.resumeMotion(recovery.state, recovery.target);
+    }
+
+    Serial.printf("Warm start: Position %.1f%% (%s)\n", recovery.position, StatusDeltaEncoder::motorName(recovery.state));
+    if (saved.state != AWNING_IDLE) {
+        if (clockKept) {
+            Serial.printf("Warm start: Motor had been running %lu ms\n", rtcTicksToMs(now - saved.movementStartTicks));
+        } else {
+            Serial.println("Warm start: Reset time unknown, assuming end position");
+        }
+    }
+    return true;
+}
+
+// Mirrors position and motion into RTC memory. Runs every loop but only
+// writes when a position tick or state change altered something.
+void updateWarmState() {
+    WarmState& state = warmState.payload;
+    float position = awning.getCurrentPosition();
+    float target = awning.getTargetPosition();
+    uint8_t motion = (uint8_t)awning.getState();
+    if (position == state.position && target == state.target && motion == state.state) {
+        return;
+    }
+
+    uint32_t now = system_get_rtc_time();
+    if (motion != state.state && motion != AWNING_IDLE) {
+        state.movementStartTicks = now;
+    }
+    state.position = position;
+    state.target = target;
+    state.state = motion;
+    state.positionTicks = now;
+    warmState.seal(RTC_WARM_STATE_MAGIC);
+    ESP.rtcUserMemoryWrite(RTC_WARM_STATE_BLOCK, (uint32_t*)&warmState, sizeof(warmState));
+}
+
 // Load settings from configuration
 void loadSettings() {
-    float currentPos = configManager.getCurrentPosition();
-    // Initialize awning controller with current position (state starts as IDLE)
-    awning.setCurrentPosition(currentPos);
     positionTracker.setTravelTime(configManager.getTravelTime());
     windSensor.setThreshold(configManager.getWindThreshold());
 
+    float currentPos = configManager.getCurrentPosition();
+    if (restoreWarmState()) {
+        currentPos = awning.getCurrentPosition();
+    } else {
+        // Initialize awning controller with current position (state starts as IDLE)
+        awning.setCurrentPosition(currentPos);
+        memset(&warmState, 0, sizeof(warmState));
+        warmState.payload.state = 0xFF;  // Forces the first write
+    }
+    updateWarmState();
+
     Serial.print("Loaded - Position: ");
     Serial.print(currentPos);
     Serial.print("%, Travel time: ");
@@ -96,30 +195,181 @@ void saveSettings() {
     configManager.save();
 }
 
+// Apply MQTT configuration and start the handler
+void beginMqtt() {
+    mqtt.begin(configManager.getMQTTServer(), configManager.getMQTTPort(), 
+              configManager.getMQTTUsername(), configManager.getMQTTPassword(),
+              configManager.getMQTTClientId());
+    mqtt.setBaseTopic(configManager.getMQTTBaseTopic());
+    mqtt.setSecondaryBroker(configManager.getMQTTSecondaryServer(), configManager.getMQTTSecondaryPort());
+    mqtt.setPersistentSession(configManager.isMQTTPersistentSession());
+    mqtt.setTls(configManager.isMQTTTlsEnabled(), configManager.getMQTTTlsFingerprint());
+    mqtt.setJsonState(configManager.isMQTTJsonState());
+}
+
+bool isMotorCommand(const char* command) {
+    return strcmp(command, "OPEN") == 0 || strcmp(command, "CLOSE") == 0 || strcmp(command, "STOP") == 0;
+}
+
+// Caller persists the position after STOP
+void applyMotorCommand(const char* command) {
+    if (strcmp(command, "OPEN") == 0) {
+        setTargetPosition(100.0, "MQTT");
+    } else if (strcmp(command, "CLOSE") == 0) {
+        setTargetPosition(0.0, "MQTT");
+    } else if (strcmp(command, "STOP") == 0) {
+        awning.stopBoth();
+        Serial.println("MQTT: Stop (both relays)");
+    }
+}
+
+// Apply motor commands queued by the web interface
+void processControlCommands() {
+    ControlCommand command;
+    while (controlCommands.pop(command)) {
+        if (command.type == CONTROL_STOP) {
+            // Use last movement relay for a remote stop
+            awning.stop(awning.getLastMovementRelay());
+            saveSettings();
+            Serial.print(command.source);
+            Serial.println(": Command STOP");
+        } else {
+            setTargetPosition(command.position, command.source);
+        }
+    }
+}
+
+// Begin a calibration of runsPerDirection extend and retract runs.
+// Returns false unless the awning is retracted.
+bool startCalibration(uint8_t runsPerDirection) {
+    if (awning.getCurrentPosition() > 5.0 || awning.isMoving()) {
+        return false;
+    }
+    calibration.begin(runsPerDirection, MIN_TRAVEL_TIME_MS);
+    Serial.print("Calibration: Started, ");
+    Serial.print(calibration.getRunsPerDirection());
+    Serial.println(" run(s) per direction");
+    return true;
+}
+
+void logTravelStats(const char* name, const TravelTimeStats& stats) {
+    Serial.printf("Calibration: %s %.0f ms, std dev %.0f ms over %u run(s)\n",
+                  name, stats.getMean(), stats.getStdDev(), stats.getCount());
+}
+
+// A wall button was pressed: during a run it marks the end position
+void handleCalibrationStop(unsigned long edgeTime) {
+    CalibrationDirection direction = calibration.getDirection();
+    if (!calibration.onStopEvent(edgeTime)) {
+        return;
+    }
+
+    // The awning is physically at its end; re-anchor the estimate there
+    awning.setCurrentPosition(direction == CALIBRATE_EXTEND ? MAX_POSITION : MIN_POSITION);
+    Serial.print("Calibration: Run ");
+    Serial.print(calibration.getCompletedRuns());
+    Serial.println(" recorded");
+
+    if (calibration.isCompleted()) {
+        unsigned long travelTime = calibration.getTravelTime();
+        configManager.setTravelTime(travelTime);
+        positionTracker.setTravelTime(configManager.getTravelTime());
+        saveSettings();
+        logTravelStats("extend", calibration.getExtendStats());
+        logTravelStats("retract", calibration.getRetractStats());
+        Serial.print("Calibration: Completed - travel time set to ");
+        Serial.print(configManager.getTravelTime());
+        Serial.println(" ms");
+    }
+}
+
+// Start the motor for the next run once the previous one has settled
+void updateCalibration() {
+    if (!calibration.isStartDue(millis(), CALIBRATION_PAUSE_MS)) {
+        return;
+    }
+
+    // The start pulse runs synchronously, so its activation is recorded on return
+    unsigned long activationsBefore = motor.getActivationCount();
+    setTargetPosition(calibration.getDirection() == CALIBRATE_EXTEND ? MAX_POSITION : MIN_POSITION, "Calibration");
+    if (motor.getActivationCount() == activationsBefore) {
+        calibration.cancel();
+        Serial.println("Calibration: Motor did not start, cancelled");
+        return;
+    }
+    calibration.onMotorStarted(motor.getLastActivationTime());
+}
+
 // Setup MQTT callbacks
 void setupMqttCallbacks() {
-    mqtt.onCommand = [](const char* command) {
-        if (strcmp(command, "OPEN") == 0) {
-            setTargetPosition(100.0, "MQTT");
-        } else if (strcmp(command, "CLOSE") == 0) {
-            setTargetPosition(0.0, "MQTT");
-        } else if (strcmp(command, "STOP") == 0) {
-            awning.stopBoth();
+    mqtt.setActuationSource(&motor);
+
+    mqtt.onCommand = [](const char* command) -> CommandResult {
+        if (!isMotorCommand(command)) {
+            return {false, "unknown_command"};
+        }
+        applyMotorCommand(command);
+        if (strcmp(command, "STOP") == 0) {
             saveSettings();
-            Serial.println("MQTT: Stop (both relays)");
         }
+        return {true, nullptr};
     };
 
-    mqtt.onSetPosition = [](float position) {
+    mqtt.onSetPosition = [](float position) -> CommandResult {
+        if (isnan(position) || position < MIN_POSITION || position > MAX_POSITION) {
+            return {false, "out_of_range"};
+        }
         setTargetPosition(position, "MQTT");
+        return {true, nullptr};
     };
 
-    mqtt.onSetWindThreshold = [](float threshold) {
+    mqtt.onSetWindThreshold = [](float threshold) -> CommandResult {
+        if (isnan(threshold) || threshold < MIN_WIND_PULSE_THRESHOLD || threshold > MAX_WIND_PULSE_THRESHOLD) {
+            return {false, "out_of_range"};
+        }
         windSensor.setThreshold((unsigned long)threshold);
+        configManager.setWindThreshold((unsigned long)threshold);
         saveSettings();
         Serial.print("Wind threshold set to: ");
         Serial.print((unsigned long)threshold);
         Serial.println(" pulses/min");
+        return {true, nullptr};
+    };
+
+    // Validate every field before touching anything, then apply together
+    // with at most one config commit
+    mqtt.onJsonCommand = [](const JsonCommand& cmd) -> CommandResult {
+        if (cmd.command && !isMotorCommand(cmd.command)) {
+            return {false, "unknown_command"};
+        }
+        if (cmd.command && cmd.hasPosition) {
+            return {false, "conflict"};
+        }
+        if (cmd.hasPosition && (isnan(cmd.position) || cmd.position < MIN_POSITION || cmd.position > MAX_POSITION)) {
+            return {false, "out_of_range"};
+        }
+        if (cmd.hasWindThreshold && (isnan(cmd.windThreshold) || cmd.windThreshold < MIN_WIND_PULSE_THRESHOLD ||
+                                     cmd.windThreshold > MAX_WIND_PULSE_THRESHOLD)) {
+            return {false, "out_of_range"};
+        }
+
+        bool persist = false;
+        if (cmd.hasWindThreshold && (unsigned long)cmd.windThreshold != windSensor.getThreshold()) {
+            windSensor.setThreshold((unsigned long)cmd.windThreshold);
+            configManager.setWindThreshold((unsigned long)cmd.windThreshold);
+            persist = true;
+        }
+        if (cmd.command) {
+            applyMotorCommand(cmd.command);
+            persist = persist || strcmp(cmd.command, "STOP") == 0;
+        } else if (cmd.hasPosition) {
+            setTargetPosition(cmd.position, "MQTT");
+        }
+
+        if (persist) {
+            saveSettings();
+        }
+        return {true, nullptr};
     };
 }
 
@@ -162,11 +412,35 @@ void handleWindSafety() {
     windSensor.update();
 
     if (windSensor.isSafetyTriggered() && awning.getCurrentPosition() > 0.0) {
+        if (configManager.isMQTTEnabled()) {
+            // Queued even while offline so the retraction is never silently lost
+            mqtt.publishEvent("wind_retract", awning.getCurrentPosition(), true);
+        }
         setTargetPosition(0.0, "Wind Safety");
         windSensor.resetSafetyTrigger();
     }
 }
 
+// Accumulate travel since the awning last rested at an end position, where
+// the estimated position is exact; position error grows with this distance
+void trackTravel() {
+    static float lastPosition = awning.getCurrentPosition();
+    float position = awning.getCurrentPosition();
+    travelSinceEndStop += fabsf(position - lastPosition);
+    lastPosition = position;
+
+    if (!awning.isMoving() && (position <= MIN_POSITION || position >= MAX_POSITION)) {
+        travelSinceEndStop = 0.0;
+    }
+}
+
+// Records the time since the previous mark against a task
+unsigned long recordTask(LoopTask task, unsigned long since) {
+    unsigned long now = micros();
+    taskStats[task].record(now - since);
+    return now;
+}
+
 // Convert AwningState to MotorState for MQTT publishing
 MotorState awningStateToMotorState(AwningState state) {
     switch (state) {
@@ -176,33 +450,119 @@ MotorState awningStateToMotorState(AwningState state) {
     }
 }
 
+// Snapshot of everything published per state cycle
+MqttStatus currentMqttStatus() {
+    MqttStatus status;
+    status.motorState = awningStateToMotorState(awning.getState());
+    status.position = awning.getCurrentPosition();
+    status.target = awning.getTargetPosition();
+    status.windPulses = windSensor.getPulsesPerMinute();
+    status.windThreshold = windSensor.getThreshold();
+    return status;
+}
+
 // Publish state periodically
 void publishState() {
     static unsigned long lastPublish = 0;
     unsigned long now = millis();
 
-    if (now - lastPublish >= 5000) {
-        mqtt.publishState(awningStateToMotorState(awning.getState()), awning.getCurrentPosition());
-        mqtt.publishWindData(windSensor.getPulsesPerMinute(),
-                           windSensor.getThreshold());
+    if (now - lastPublish >= MQTT_STATE_REFRESH_MS) {
+        mqtt.publishStatus(currentMqttStatus());
         lastPublish = now;
     }
 }
 
+// Buttons, calibration and the motor state machine
+void runControlTasks() {
+    // Handle buttons FIRST - they have priority over all other commands
+    bool buttonPressed = handleExtendButton() || handleRetractButton();
+
+    // Both are read so neither keeps a stale edge
+    unsigned long edgeTime;
+    bool extendEdge = extendButton.takePressEdge(edgeTime);
+    bool retractEdge = retractButton.takePressEdge(edgeTime);
+    if ((extendEdge || retractEdge) && calibration.isActive()) {
+        handleCalibrationStop(edgeTime);
+    }
+
+    // Update awning state machine (handles motor control)
+    static bool wasMoving = false;
+    if (!buttonPressed) {
+        processControlCommands();
+        updateCalibration();
+        awning.update();
+        // Save settings when motor stops
+        bool isMoving = awning.isMoving();
+        if (wasMoving && !isMoving) {
+            saveSettings();
+            if (configManager.isMQTTEnabled()) {
+                mqtt.publishStatus(currentMqttStatus(), true);
+            }
+        }
+        wasMoving = isMoving;
+    }
+    trackTravel();
+    updateWarmState();
+}
+
+// Everything that must keep running while a long operation such as a
+// firmware upload holds up loop()
+void runSafetyTasks() {
+    runControlTasks();
+    handleWindSafety();
+}
+
+// Time per stage up to and including last
+void logBootStages(BootStage last) {
+    for (int i = 0; i <= last; i++) {
+        if (bootTimeline.isReached(i)) {
+            Serial.printf("Boot: %-10s at %6lu us (+%lu us)\n", BOOT_STAGE_NAMES[i],
+                          (unsigned long)bootTimeline.getUs(i), (unsigned long)bootTimeline.getDurationUs(i));
+        }
+    }
+}
+
+// Brings up everything needed for safe operation, in order, and nothing
+// else: WiFi, MQTT and mDNS are started from loop() afterwards
 void setup() {
+    // Relay pins float until configured; drive them off before anything else
+    motor.begin();
+    markBootStage(BOOT_RELAYS);
+    
     Serial.begin(115200);
     Serial.println("\nESP8266 Awning Controller Starting...");
     
+    initializeInputs();
+    markBootStage(BOOT_INPUTS);
+    
     initializeConfig();
-    initializeComponents();
+    markBootStage(BOOT_CONFIG);
+    
     loadSettings();
+    markBootStage(BOOT_POSITION);
     
     setupMqttCallbacks();
     
+    logBootStages(BOOT_POSITION);
+    unsigned long safeMs = bootTimeline.getMs(BOOT_POSITION);
+    if (safeMs > BOOT_SAFE_BUDGET_MS) {
+        Serial.printf("Boot: Safe after %lu ms, over the %lu ms budget\n", safeMs, BOOT_SAFE_BUDGET_MS);
+    }
     Serial.println("Setup complete!");
 }
 
 void loop() {
+    unsigned long loopStart = micros();
+    unsigned long mark = loopStart;
+    
+    // Networking starts on the first pass, once setup() has made everything safe
+    static bool networkStarted = false;
+    if (!networkStarted) {
+        wifiManager.begin();
+        networkStarted = true;
+        markBootStage(BOOT_WIFI_START);
+    }
+    
     // Update WiFi manager (handles connection, fallback, config portal)
     wifiManager.update();
     
@@ -220,26 +580,29 @@ void loop() {
             MDNS.addService("http", "tcp", 80);
             MDNS.addServiceTxt("http", "tcp", "device", "sonnensegel");
             MDNS.addServiceTxt("http", "tcp", "version", "1.0");
+            MDNS.addService("awning", "udp", UDP_CONTROL_PORT);
             Serial.println("mDNS: HTTP service announced");
         } else {
             Serial.println("mDNS: Failed to start");
         }
         
         webInterface.begin();
+        udpControl.begin(UDP_CONTROL_PORT);
         servicesInitialized = true;
         Serial.println("Web interface initialized");
+        if (markBootStage(BOOT_NETWORK)) {
+            Serial.printf("Boot: Network up %lu ms after boot\n", bootTimeline.getMs(BOOT_NETWORK));
+        }
         
         // Initialize MQTT only if enabled
         if (configManager.isMQTTEnabled() && !mqttInitialized) {
-            mqtt.begin(configManager.getMQTTServer(), configManager.getMQTTPort(), 
-                      configManager.getMQTTUsername(), configManager.getMQTTPassword(),
-                      configManager.getMQTTClientId());
-            mqtt.setBaseTopic(configManager.getMQTTBaseTopic());
+            beginMqtt();
             mqttInitialized = true;
             Serial.println("MQTT service initialized");
         }
     } else if (!wifiManager.isConnected() && servicesInitialized) {
         MDNS.end();
+        udpControl.stop();
         servicesInitialized = false;
         mqttInitialized = false;
         Serial.println("Network services stopped");
@@ -248,10 +611,7 @@ void loop() {
     // Handle MQTT enable/disable changes
     if (wifiManager.isConnected() && servicesInitialized) {
         if (configManager.isMQTTEnabled() && !mqttInitialized) {
-            mqtt.begin(configManager.getMQTTServer(), configManager.getMQTTPort(), 
-                      configManager.getMQTTUsername(), configManager.getMQTTPassword(),
-                      configManager.getMQTTClientId());
-            mqtt.setBaseTopic(configManager.getMQTTBaseTopic());
+            beginMqtt();
             mqttInitialized = true;
             Serial.println("MQTT service enabled");
         } else if (!configManager.isMQTTEnabled() && mqttInitialized) {
@@ -260,34 +620,35 @@ void loop() {
         }
     }
     
-    // Handle buttons FIRST - they have priority over all other commands
-    bool buttonPressed = handleExtendButton() || handleRetractButton();
-
-    // Update awning state machine (handles motor control)
-    static bool wasMoving = false;
-    if (!buttonPressed) {
-        awning.update();
-        // Save settings when motor stops
-        bool isMoving = awning.isMoving();
-        if (wasMoving && !isMoving) {
-            saveSettings();
-        }
-        wasMoving = isMoving;
-    }
+    mark = recordTask(TASK_WIFI, mark);
+    
+    runControlTasks();
+    mark = recordTask(TASK_CONTROL, mark);
 
     handleWindSafety();
+    mark = recordTask(TASK_WIND, mark);
     
     // Only run network services if connected
     if (servicesInitialized) {
         MDNS.update();
         webInterface.loop();
+        udpControl.loop();
+        mark = recordTask(TASK_WEB, mark);
         
         // Only run MQTT services if enabled and initialized
         if (mqttInitialized) {
             mqtt.loop();
             publishState();
+            
+            if (mqtt.isConnected() && markBootStage(BOOT_MQTT)) {
+                Serial.printf("Boot: MQTT online %lu ms after boot (WiFi %s connect took %lu ms)\n",
+                              bootTimeline.getMs(BOOT_MQTT),
+                              wifiManager.wasFastConnect() ? "fast" : "full", wifiManager.getLastConnectDuration());
+            }
+            recordTask(TASK_MQTT, mark);
         }
     }
     
+    loopStats.record(micros() - loopStart);
     yield();
 }
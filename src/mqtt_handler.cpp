@@ -1,18 +1,47 @@
 #include "mqtt_handler.h"
 #include "constants.h"
+#include "mqtt_ca_cert.h"
 #include <ArduinoJson.h>
+#include <time.h>
 
 MqttHandler* mqttHandlerInstance = nullptr;
 
+const char* MqttHandler::HA_STATUS_TOPIC = "homeassistant/status";
+
+// FNV-1a, used to detect discovery payload changes
+static uint32_t hashPayload(const char* data) {
+    uint32_t hash = 2166136261UL;
+    while (*data) {
+        hash ^= (uint8_t)*data++;
+        hash *= 16777619UL;
+    }
+    return hash;
+}
+
 MqttHandler::MqttHandler() 
-    : mqttClient(wifiClient), lastReconnectAttempt(0), lastPublish(0), 
-      connectionStartTime(0), connectingInProgress(false), failedAttempts(0), port(1883) {
+    : trustAnchors(nullptr), netClient(&wifiClient), mqttClient(wifiClient), 
+      lastReconnectAttempt(0), lastPublish(0), 
+      connectionStartTime(0), connectingInProgress(false), failedAttempts(0), wasConnected(false), 
+      persistentSession(false), tlsEnabled(false), tlsConfigured(false), tlsSessionValid(false), tlsProbedBroker(-1),
+      lastConnectMs(0), lastConnectHeapUsed(0), lastConnectResumed(false), 
+      connectFailures(0), publishCount(0), publishFailures(0), 
+      fastRetry(false), outageStart(0), lastFailoverMs(0), 
+      coverDiscoveryHash(0), windDiscoveryHash(0), discoveryPending(false), discoveryDueAt(0),
+      subscribedAt(0), jsonState(false), jsonStatePending(false), actuationSource(nullptr),
+      port(1883), secondaryPort(1883) {
     mqttHandlerInstance = this;
     strcpy(server, "");
+    strcpy(secondaryServer, "");
     strcpy(username, "");
     strcpy(password, "");
     strcpy(clientId, "awning_controller");
     strcpy(baseTopic, "home/awning");
+    strcpy(tlsFingerprint, "");
+    strcpy(jsonStateBuffer, "");
+    
+    // Topics must be valid before begin() so messages can be queued offline
+    buildTopics();
+    outbound.setRateLimit(MQTT_QUEUE_FLUSH_BURST, MQTT_QUEUE_FLUSH_INTERVAL_MS);
 }
 
 void MqttHandler::buildTopics() {
@@ -24,6 +53,10 @@ void MqttHandler::buildTopics() {
     snprintf(windPulsesTopic, sizeof(windPulsesTopic), "%s/wind_pulses", baseTopic);
     snprintf(windThresholdTopic, sizeof(windThresholdTopic), "%s/wind_threshold", baseTopic);
     snprintf(setWindThresholdTopic, sizeof(setWindThresholdTopic), "%s/set_wind_threshold", baseTopic);
+    snprintf(eventTopic, sizeof(eventTopic), "%s/event", baseTopic);
+    snprintf(jsonStateTopic, sizeof(jsonStateTopic), "%s/json", baseTopic);
+    snprintf(ackTopic, sizeof(ackTopic), "%s/ack", baseTopic);
+    snprintf(jsonCommandTopic, sizeof(jsonCommandTopic), "%s/command", baseTopic);
     
     // Build Home Assistant discovery topics
     snprintf(discoveryTopic, sizeof(discoveryTopic), "homeassistant/cover/%s/config", clientId);
@@ -43,9 +76,13 @@ void MqttHandler::begin(const char* srv, uint16_t prt, const char* user,
     clientId[sizeof(clientId) - 1] = '\0';
     
     buildTopics();
-    mqttClient.setServer(server, port);
+    failover.switchToPrimary();
+    applyActiveBroker();
     mqttClient.setCallback(staticCallback);
-    mqttClient.setBufferSize(1536);
+    mqttClient.setBufferSize(MQTT_BUFFER_SIZE);
+    
+    // Wall clock for rejecting stale timestamped commands
+    configTime(0, 0, "pool.ntp.org", "time.nist.gov");
 }
 
 void MqttHandler::setBaseTopic(const char* topic) {
@@ -54,22 +91,117 @@ void MqttHandler::setBaseTopic(const char* topic) {
     buildTopics();
 }
 
+void MqttHandler::setSecondaryBroker(const char* srv, uint16_t prt) {
+    strncpy(secondaryServer, srv, sizeof(secondaryServer) - 1);
+    secondaryServer[sizeof(secondaryServer) - 1] = '\0';
+    secondaryPort = prt;
+    
+    failover.setBrokerCount(strlen(secondaryServer) > 0 ? 2 : 1);
+    applyActiveBroker();
+}
+
+void MqttHandler::applyActiveBroker() {
+    primaryProbe.cancel();
+    mqttClient.setServer(activeServer(), activePort());
+    // A cached TLS session only applies to the broker it came from
+    tlsSessionValid = false;
+}
+
+void MqttHandler::setTls(bool enabled, const char* fingerprint) {
+    tlsEnabled = enabled;
+    strncpy(tlsFingerprint, fingerprint, sizeof(tlsFingerprint) - 1);
+    tlsFingerprint[sizeof(tlsFingerprint) - 1] = '\0';
+    tlsConfigured = false;
+    tlsSessionValid = false;
+    tlsProbedBroker = -1;
+    
+    netClient = tlsEnabled ? &secureClient : &wifiClient;
+    mqttClient.setClient(*netClient);
+}
+
+void MqttHandler::configureTls() {
+    // Small record buffers if the broker about to be connected to supports
+    // max fragment length negotiation; probed again after a failover
+    if (tlsProbedBroker != failover.getActiveIndex()) {
+        tlsProbedBroker = failover.getActiveIndex();
+        if (secureClient.probeMaxFragmentLength(activeServer(), activePort(), 1024)) {
+            secureClient.setBufferSizes(1024, 1024);
+            Serial.println("MQTT TLS: Using 1 KB record buffers");
+        }
+    }
+    
+    if (tlsConfigured) {
+        return;
+    }
+    
+    if (strlen(tlsFingerprint) > 0) {
+        secureClient.setFingerprint(tlsFingerprint);
+        Serial.println("MQTT TLS: Pinned by certificate fingerprint");
+    } else if (strlen_P(MQTT_CA_CERT) > 0) {
+        if (!trustAnchors) {
+            trustAnchors = new BearSSL::X509List(MQTT_CA_CERT);
+        }
+        secureClient.setTrustAnchors(trustAnchors);
+        Serial.println("MQTT TLS: Pinned by CA certificate");
+    } else {
+        secureClient.setInsecure();
+        Serial.println("MQTT TLS: WARNING - no fingerprint or CA, server is not verified");
+    }
+    
+    secureClient.setSession(&tlsSession);
+    tlsConfigured = true;
+}
+
 void MqttHandler::staticCallback(char* topic, byte* payload, unsigned int length) {
-    if (mqttHandlerInstance) {
-        char message[length + 1];
-        memcpy(message, payload, length);
-        message[length] = '\0';
-        mqttHandlerInstance->processMessage(topic, message);
+    if (!mqttHandlerInstance) {
+        return;
+    }
+    
+    // Commands are decoded straight from the client buffer
+    MqttCommandTopic command = mqttCommandForTopic(topic, mqttHandlerInstance->baseTopic);
+    if (command != MQTT_COMMAND_NONE) {
+        mqttHandlerInstance->processCommand(command, (const char*)payload, length);
+        return;
     }
+    
+    char message[length + 1];
+    memcpy(message, payload, length);
+    message[length] = '\0';
+    mqttHandlerInstance->processMessage(topic, message);
 }
 
 void MqttHandler::subscribe() {
-    mqttClient.subscribe(commandTopic);
-    mqttClient.subscribe(setPositionTopic);
-    mqttClient.subscribe(setWindThresholdTopic);
+    // QoS1 lets the broker hold commands for a persistent session while we are away
+    uint8_t qos = persistentSession ? 1 : 0;
+    mqttClient.subscribe(commandTopic, qos);
+    mqttClient.subscribe(setPositionTopic, qos);
+    mqttClient.subscribe(setWindThresholdTopic, qos);
+    mqttClient.subscribe(jsonCommandTopic, qos);
+    mqttClient.subscribe(HA_STATUS_TOPIC);
+    subscribedAt = millis();
+}
+
+void MqttHandler::scheduleDiscovery() {
+    // Random jitter so a fleet does not hit the broker at the same moment
+    discoveryPending = true;
+    discoveryDueAt = millis() + random(MQTT_DISCOVERY_JITTER_MS);
+}
+
+bool MqttHandler::publishDiscoveryPayload(const char* topic, const char* payload, 
+                                          uint32_t& publishedHash, bool force) {
+    uint32_t hash = hashPayload(payload);
+    if (!force && hash == publishedHash) {
+        return false;
+    }
+    
+    if (sendMessage(topic, payload, true)) {
+        publishedHash = hash;
+        return true;
+    }
+    return false;
 }
 
-void MqttHandler::publishDiscovery() {
+void MqttHandler::publishDiscovery(bool force) {
     if (!isConnected()) {
         return;
     }
@@ -81,9 +213,17 @@ void MqttHandler::publishDiscovery() {
         doc["name"] = "Awning";
         doc["unique_id"] = clientId;
         doc["command_topic"] = commandTopic;
-        doc["state_topic"] = stateTopic;
-        doc["position_topic"] = positionTopic;
         doc["set_position_topic"] = setPositionTopic;
+        if (jsonState) {
+            doc["state_topic"] = jsonStateTopic;
+            doc["value_template"] = "{{ value_json.state }}";
+            doc["position_topic"] = jsonStateTopic;
+            doc["position_template"] = "{{ value_json.position }}";
+            doc["json_attributes_topic"] = jsonStateTopic;
+        } else {
+            doc["state_topic"] = stateTopic;
+            doc["position_topic"] = positionTopic;
+        }
         doc["availability_topic"] = availabilityTopic;
         
         // Command payloads
@@ -112,10 +252,10 @@ void MqttHandler::publishDiscovery() {
         
         char buffer[1024];
         serializeJson(doc, buffer);
-        mqttClient.publish(discoveryTopic, buffer, true);
-        
-        Serial.print("Published discovery to: ");
-        Serial.println(discoveryTopic);
+        if (publishDiscoveryPayload(discoveryTopic, buffer, coverDiscoveryHash, force)) {
+            Serial.print("Published discovery to: ");
+            Serial.println(discoveryTopic);
+        }
     }
     
     // Publish wind sensor discovery message
@@ -124,7 +264,12 @@ void MqttHandler::publishDiscovery() {
         
         doc["name"] = "Awning Wind Sensor";
         doc["unique_id"] = String(clientId) + "_wind";
-        doc["state_topic"] = windPulsesTopic;
+        if (jsonState) {
+            doc["state_topic"] = jsonStateTopic;
+            doc["value_template"] = "{{ value_json.wind_pulses }}";
+        } else {
+            doc["state_topic"] = windPulsesTopic;
+        }
         doc["availability_topic"] = availabilityTopic;
         doc["unit_of_measurement"] = "pulses/min";
         doc["icon"] = "mdi:weather-windy";
@@ -139,10 +284,10 @@ void MqttHandler::publishDiscovery() {
         
         char buffer[512];
         serializeJson(doc, buffer);
-        mqttClient.publish(windDiscoveryTopic, buffer, true);
-        
-        Serial.print("Published wind sensor discovery to: ");
-        Serial.println(windDiscoveryTopic);
+        if (publishDiscoveryPayload(windDiscoveryTopic, buffer, windDiscoveryHash, force)) {
+            Serial.print("Published wind sensor discovery to: ");
+            Serial.println(windDiscoveryTopic);
+        }
     }
 }
 
@@ -158,7 +303,9 @@ bool MqttHandler::reconnect() {
     if (!connectingInProgress) {
         // Calculate backoff delay based on failed attempts
         unsigned long backoffDelay = MQTT_RECONNECT_INTERVAL_MS;  // Start with 5 seconds
-        if (failedAttempts > 0) {
+        if (fastRetry) {
+            backoffDelay = 0;  // Failing over to the next broker
+        } else if (failedAttempts > 0) {
             backoffDelay = MQTT_BACKOFF_BASE_MS * min(failedAttempts, 4UL);  // Then 30s, 60s, 90s, 120s
         }
         
@@ -174,38 +321,80 @@ bool MqttHandler::reconnect() {
         Serial.print("Attempting MQTT connection (attempt ");
         Serial.print(failedAttempts + 1);
         Serial.println(")");
-        Serial.print("MQTT Config - Server: ");
-        Serial.print(server);
+        Serial.print("MQTT Config - Broker: ");
+        Serial.print(failover.getActiveIndex() + 1);
+        Serial.print("/");
+        Serial.print(failover.getBrokerCount());
+        Serial.print(", Server: ");
+        Serial.print(activeServer());
         Serial.print(", Port: ");
-        Serial.print(port);
+        Serial.print(activePort());
         Serial.print(", ClientID: ");
         Serial.print(clientId);
         Serial.print(", Username: ");
         Serial.print(strlen(username) > 0 ? username : "(none)");
         Serial.print(", HasPassword: ");
         Serial.print(strlen(password) > 0 ? "yes" : "no");
+        Serial.print(", PersistentSession: ");
+        Serial.print(persistentSession ? "yes" : "no");
         Serial.print(", AvailabilityTopic: ");
         Serial.println(availabilityTopic);
         
         // Set very short timeout to prevent blocking
-        wifiClient.setTimeout(1000);
+        netClient->setTimeout(1000);
         mqttClient.setSocketTimeout(1);
         
-        bool connected;
-        if (strlen(username) > 0) {
-            connected = mqttClient.connect(clientId, username, password, 
-                                         availabilityTopic, 0, true, "offline");
-        } else {
-            connected = mqttClient.connect(clientId, availabilityTopic, 0, true, "offline");
+        if (tlsEnabled) {
+            configureTls();
+            time_t nowEpoch = time(nullptr);
+            if ((unsigned long)nowEpoch >= MIN_VALID_EPOCH) {
+                secureClient.setX509Time(nowEpoch);
+            }
         }
         
+        // The broker resumed the session only if it accepted the ID offered
+        uint8_t offeredSessionId[32];
+        size_t offeredSessionIdLength = 0;
+        if (tlsEnabled && tlsSessionValid) {
+            const br_ssl_session_parameters* params = tlsSession.getSession();
+            offeredSessionIdLength = params->session_id_len;
+            memcpy(offeredSessionId, params->session_id, offeredSessionIdLength);
+        }
+        
+        uint32_t heapBefore = ESP.getFreeHeap();
+        unsigned long connectStart = millis();
+        
+        bool hasCredentials = strlen(username) > 0;
+        bool connected = mqttClient.connect(clientId, 
+                                            hasCredentials ? username : nullptr,
+                                            hasCredentials ? password : nullptr,
+                                            availabilityTopic, 0, true, "offline",
+                                            !persistentSession);
+        
+        lastConnectMs = millis() - connectStart;
+        lastConnectHeapUsed = (long)heapBefore - (long)ESP.getFreeHeap();
+        // A full handshake stores a new session ID from the broker
+        const br_ssl_session_parameters* session = tlsSession.getSession();
+        lastConnectResumed = connected && offeredSessionIdLength > 0 &&
+                             session->session_id_len == offeredSessionIdLength &&
+                             memcmp(session->session_id, offeredSessionId, offeredSessionIdLength) == 0;
         connectingInProgress = false;
         
         if (!connected) {
-            failedAttempts++;
+            connectFailures++;
             Serial.print("failed, rc=");
-            Serial.print(mqttClient.state());
-            Serial.print(" (attempt ");
+            Serial.println(mqttClient.state());
+            
+            fastRetry = failover.onConnectFailed();
+            applyActiveBroker();
+            if (fastRetry) {
+                Serial.print("MQTT: Failing over to ");
+                Serial.println(activeServer());
+                return false;
+            }
+            
+            failedAttempts++;
+            Serial.print("MQTT: All brokers failed (attempt ");
             Serial.print(failedAttempts);
             Serial.println(")");
             
@@ -217,10 +406,32 @@ bool MqttHandler::reconnect() {
         
         // Connection successful
         failedAttempts = 0;
-        Serial.println("connected");
-        mqttClient.publish(availabilityTopic, "online", true);
+        fastRetry = false;
+        failover.onConnected(millis());
+        if (outageStart != 0) {
+            lastFailoverMs = millis() - outageStart;
+            outageStart = 0;
+            Serial.print("MQTT: Back online via ");
+            Serial.print(activeServer());
+            Serial.print(" after ");
+            Serial.print(lastFailoverMs);
+            Serial.println(" ms");
+        }
+        Serial.print("connected in ");
+        Serial.print(lastConnectMs);
+        Serial.print(" ms, heap used: ");
+        Serial.print(lastConnectHeapUsed);
+        if (tlsEnabled) {
+            Serial.print(" bytes, TLS handshake: ");
+            Serial.println(lastConnectResumed ? "resumed" : "full");
+            tlsSessionValid = true;
+        } else {
+            Serial.println(" bytes");
+        }
+        sendMessage(availabilityTopic, "online", true);
         subscribe();
-        publishDiscovery();
+        // Retained configs are already on the broker unless they changed
+        publishDiscovery(false);
         return true;
     }
     
@@ -229,7 +440,8 @@ bool MqttHandler::reconnect() {
         Serial.println("MQTT connection timeout");
         connectingInProgress = false;
         failedAttempts++;
-        wifiClient.stop();
+        connectFailures++;
+        netClient->stop();
         return false;
     }
     
@@ -242,61 +454,190 @@ void MqttHandler::loop() {
     }
     
     if (!mqttClient.connected()) {
+        if (wasConnected) {
+            // Anything not yet past its ack window may be lost - resend after reconnect
+            outbound.onConnectionLost();
+            wasConnected = false;
+            outageStart = millis();
+            primaryProbe.cancel();
+        }
         reconnect();
         return;
     }
     
+    wasConnected = true;
     mqttClient.loop();
+    
+    if (discoveryPending && (long)(millis() - discoveryDueAt) >= 0) {
+        discoveryPending = false;
+        publishDiscovery(true);
+    }
+    
+    // Return to the primary broker once it is reachable again. The probe is
+    // TCP reachability only and completes in the background over several loops.
+    if (!primaryProbe.isRunning() && failover.shouldProbePrimary(millis(), MQTT_PRIMARY_PROBE_INTERVAL_MS)) {
+        primaryProbe.start(server, port, millis());
+    }
+    if (primaryProbe.poll(millis(), MQTT_PROBE_TIMEOUT_MS) == PROBE_REACHABLE && !failover.isOnPrimary()) {
+        Serial.println("MQTT: Primary broker reachable, switching back");
+        sendMessage(availabilityTopic, "offline", true);
+        mqttClient.disconnect();
+        failover.switchToPrimary();
+        applyActiveBroker();
+        fastRetry = true;
+        return;
+    }
+    
+    outbound.settle(millis(), MQTT_QUEUE_ACK_WINDOW_MS);
+    flushOutbound();
 }
 
-void MqttHandler::publishState(MotorState motorState, float position) {
+// Every publish goes through here so the counts cover all topics
+bool MqttHandler::sendMessage(const char* topic, const char* payload, bool retained) {
+    if (mqttClient.publish(topic, payload, retained)) {
+        publishCount++;
+        return true;
+    }
+    publishFailures++;
+    return false;
+}
+
+void MqttHandler::flushOutbound() {
     if (!isConnected()) {
         return;
     }
     
+    if (jsonStatePending && sendMessage(jsonStateTopic, jsonStateBuffer, true)) {
+        jsonStatePending = false;
+    }
+    
+    if (outbound.isEmpty()) {
+        return;
+    }
+    
+    outbound.flush(millis(), [this](const char* topic, const char* payload, bool retained) {
+        return sendMessage(topic, payload, retained);
+    });
+}
+
+const char* MqttHandler::stateName(MotorState motorState, float position) {
+    if (motorState == MOTOR_EXTENDING) {
+        return "opening";
+    }
+    if (motorState == MOTOR_RETRACTING) {
+        return "closing";
+    }
+    // Motor is stopped - determine if open, closed, or stopped
+    if (position >= 99.0) {
+        return "open";
+    }
+    if (position <= 1.0) {
+        return "closed";
+    }
+    return "stopped";
+}
+
+void MqttHandler::publishStatus(const MqttStatus& status, bool force) {
+    if (!jsonState) {
+        publishState(status.motorState, status.position, force);
+        publishWindData(status.windPulses, status.windThreshold);
+        return;
+    }
+    
     unsigned long now = millis();
-    if (now - lastPublish < MQTT_PUBLISH_INTERVAL_MS) {
+    if (!force && now - lastPublish < MQTT_PUBLISH_INTERVAL_MS) {
         return;
     }
     
     lastPublish = now;
+    publishJsonState(status);
+}
+
+void MqttHandler::publishJsonState(const MqttStatus& status) {
+    char positionStr[10];
+    char targetStr[10];
+    dtostrf(status.position, 1, 1, positionStr);
+    dtostrf(status.target, 1, 1, targetStr);
     
-    // Determine state based on motor state and position
-    const char* state;
-    if (motorState == MOTOR_EXTENDING) {
-        state = "opening";
-    } else if (motorState == MOTOR_RETRACTING) {
-        state = "closing";
-    } else {
-        // Motor is stopped - determine if open, closed, or stopped
-        if (position >= 99.0) {
-            state = "open";
-        } else if (position <= 1.0) {
-            state = "closed";
-        } else {
-            state = "stopped";
-        }
+    // Written into the same buffer every cycle; only the latest state is kept
+    snprintf(jsonStateBuffer, sizeof(jsonStateBuffer),
+             "{\"state\":\"%s\",\"position\":%s,\"target\":%s,"
+             "\"wind_pulses\":%lu,\"wind_threshold\":%lu,"
+             "\"uptime\":%lu,\"rssi\":%d,\"free_heap\":%lu,"
+             "\"mqtt_queued\":%u,\"mqtt_dropped\":%lu,\"broker\":%u}",
+             stateName(status.motorState, status.position), positionStr, targetStr,
+             status.windPulses, status.windThreshold,
+             millis(), (int)WiFi.RSSI(), (unsigned long)ESP.getFreeHeap(),
+             (unsigned)outbound.size(), outbound.getDroppedCount(), 
+             (unsigned)failover.getActiveIndex());
+    jsonStatePending = true;
+    
+    flushOutbound();
+}
+
+void MqttHandler::publishState(MotorState motorState, float position, bool force) {
+    unsigned long now = millis();
+    if (!force && now - lastPublish < MQTT_PUBLISH_INTERVAL_MS) {
+        return;
     }
     
-    mqttClient.publish(stateTopic, state, true);
+    lastPublish = now;
+    
+    outbound.enqueueState(stateTopic, stateName(motorState, position), true);
     
     char positionStr[10];
     dtostrf(position, 4, 1, positionStr);
-    mqttClient.publish(positionTopic, positionStr, true);
+    outbound.enqueueState(positionTopic, positionStr, true);
+    
+    flushOutbound();
 }
 
 void MqttHandler::publishWindData(unsigned long pulses, unsigned long threshold) {
-    if (!isConnected()) {
-        return;
-    }
-    
     char pulsesStr[10];
     sprintf(pulsesStr, "%lu", pulses);
-    mqttClient.publish(windPulsesTopic, pulsesStr, true);
+    outbound.enqueueState(windPulsesTopic, pulsesStr, true);
     
     char thresholdStr[10];
     sprintf(thresholdStr, "%lu", threshold);
-    mqttClient.publish(windThresholdTopic, thresholdStr, true);
+    outbound.enqueueState(windThresholdTopic, thresholdStr, true);
+    
+    flushOutbound();
+}
+
+void MqttHandler::publishEvent(const char* event, float position, bool important) {
+    // Uptime lets consumers order events that were delivered late
+    char positionStr[10];
+    dtostrf(position, 1, 1, positionStr);
+    
+    char payload[OutboundMessage::PAYLOAD_SIZE];
+    snprintf(payload, sizeof(payload), "{\"event\":\"%s\",\"position\":%s,\"uptime\":%lu}",
+             event, positionStr, millis());
+    outbound.enqueueEvent(eventTopic, payload, false, important);
+    
+    flushOutbound();
+}
+
+unsigned long MqttHandler::wallClock() {
+    // 0 while the clock is not synced, so timestamps cannot be judged and are accepted
+    time_t now = time(nullptr);
+    return (unsigned long)now < MIN_VALID_EPOCH ? 0 : (unsigned long)now;
+}
+
+void MqttHandler::publishAck(MqttCommandTopic topic, const char* id, unsigned long receivedAt,
+                             const CommandResult& result, unsigned long activationsBefore) {
+    if (!isConnected()) {
+        return;
+    }
+    
+    // Latency from receipt to the first relay switched on by this command
+    long latencyMs = -1;
+    if (actuationSource && actuationSource->getActivationCount() != activationsBefore) {
+        latencyMs = (long)(actuationSource->getLastActivationTime() - receivedAt);
+    }
+    
+    char payload[192];
+    formatMqttAck(payload, sizeof(payload), topic, id, result, latencyMs, millis() - receivedAt);
+    sendMessage(ackTopic, payload, false);
 }
 
 void MqttHandler::processMessage(char* topic, char* message) {
@@ -305,13 +646,34 @@ void MqttHandler::processMessage(char* topic, char* message) {
     Serial.print("]: ");
     Serial.println(message);
     
-    if (strcmp(topic, commandTopic) == 0 && onCommand) {
-        onCommand(message);
-    } else if (strcmp(topic, setPositionTopic) == 0 && onSetPosition) {
-        float position = atof(message);
-        onSetPosition(position);
-    } else if (strcmp(topic, setWindThresholdTopic) == 0 && onSetWindThreshold) {
-        float threshold = atof(message);
-        onSetWindThreshold(threshold);
+    if (strcmp(topic, HA_STATUS_TOPIC) == 0) {
+        // A retained birth message is replayed on every subscribe - only react to live ones
+        bool replayed = millis() - subscribedAt < MQTT_RETAINED_BIRTH_WINDOW_MS;
+        if (strcmp(message, "online") == 0 && !replayed) {
+            Serial.println("MQTT: Home Assistant online, discovery scheduled");
+            scheduleDiscovery();
+        }
     }
-}
\ No newline at end of file
+}
+
+void MqttHandler::processCommand(MqttCommandTopic topic, const char* payload, size_t length) {
+    unsigned long receivedAt = millis();
+    unsigned long activationsBefore = actuationSource ? actuationSource->getActivationCount() : 0;
+    
+    Serial.print("MQTT command [");
+    Serial.print(MQTT_COMMAND_NAMES[topic]);
+    Serial.print("]: ");
+    Serial.write((const uint8_t*)payload, length);
+    Serial.println();
+    
+    MqttCommand command;
+    CommandResult result = decodeMqttCommand(topic, payload, length, wallClock(), MQTT_COMMAND_MAX_AGE_S, command);
+    if (result.accepted) {
+        result = dispatchMqttCommand(command, *this);
+    } else {
+        Serial.print("MQTT: Command rejected: ");
+        Serial.println(result.reason);
+    }
+    
+    publishAck(topic, command.getId(), receivedAt, result, activationsBefore);
+}
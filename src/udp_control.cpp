@@ -0,0 +1,113 @@
+#include "udp_control.h"
+#include "awning_controller.h"
+#include "wind_sensor.h"
+#include "calibration_session.h"
+#include "control_command_queue.h"
+
+extern AwningController awning;
+extern WindSensor windSensor;
+extern ControlCommandQueue controlCommands;
+extern CalibrationSession calibration;
+
+UdpControl::UdpControl() : running(false), packetCount(0), droppedCount(0) {}
+
+void UdpControl::begin(uint16_t port) {
+    running = udp.begin(port) == 1;
+    if (running) {
+        Serial.printf("UDP: Control endpoint on port %u\n", port);
+    } else {
+        Serial.println("UDP: Failed to open control port");
+    }
+}
+
+void UdpControl::stop() {
+    if (running) {
+        udp.stop();
+        running = false;
+    }
+}
+
+void UdpControl::loop() {
+    if (!running) {
+        return;
+    }
+
+    // Bounded so a flood cannot hold up the control loop
+    for (uint8_t i = 0; i < UDP_CONTROL_MAX_PACKETS_PER_LOOP; i++) {
+        int size = udp.parsePacket();
+        if (size <= 0) {
+            return;
+        }
+        packetCount++;
+
+        uint8_t packet[UDP_REQUEST_SIZE];
+        UdpRequest request;
+        if ((size_t)size != UDP_REQUEST_SIZE ||
+            udp.read(packet, sizeof(packet)) != (int)sizeof(packet) ||
+            !parseUdpRequest(packet, sizeof(packet), request)) {
+            // Not ours or malformed; no answer, so spoofed sources get no reflection
+            droppedCount++;
+            continue;
+        }
+
+        IPAddress address = udp.remoteIP();
+        uint16_t port = udp.remotePort();
+        uint8_t result = handleRequest(request, (uint32_t)address, port);
+
+        // The queued target is applied later in the loop; report it now so
+        // the answer confirms the command
+        UdpStatus status = currentStatus();
+        if (request.type == UDP_SET_POSITION && result == UDP_OK) {
+            status.targetTenths = request.argument;
+        }
+
+        uint8_t response[UDP_RESPONSE_SIZE];
+        encodeUdpResponse(request, result, status, response);
+        udp.beginPacket(address, port);
+        udp.write(response, sizeof(response));
+        udp.endPacket();
+    }
+}
+
+uint8_t UdpControl::handleRequest(const UdpRequest& request, uint32_t address, uint16_t port) {
+    if (request.type == UDP_STATUS) {
+        return UDP_OK;
+    }
+    if (request.type != UDP_SET_POSITION && request.type != UDP_STOP) {
+        return UDP_BAD_REQUEST;
+    }
+
+    // A retransmission of a command already handled is answered, not re-applied
+    uint8_t result;
+    if (sequences.isDuplicate(address, port, request.sequence, result)) {
+        return result;
+    }
+
+    ControlCommand command = {CONTROL_STOP, 0.0, "UDP"};
+    if (request.type == UDP_SET_POSITION) {
+        if (request.argument > MAX_POSITION * 10) {
+            result = UDP_OUT_OF_RANGE;
+            sequences.record(address, port, request.sequence, result);
+            return result;
+        }
+        command.type = CONTROL_SET_TARGET;
+        command.position = request.argument / 10.0f;
+    }
+    result = controlCommands.push(command) ? UDP_OK : UDP_BUSY;
+    // A busy command was not applied, so its retry must not be treated as a duplicate
+    if (result != UDP_BUSY) {
+        sequences.record(address, port, request.sequence, result);
+    }
+    return result;
+}
+
+UdpStatus UdpControl::currentStatus() {
+    UdpStatus status;
+    status.motorState = (uint8_t)awning.getState();  // Same numbering as the protocol
+    status.positionTenths = (uint16_t)(awning.getCurrentPosition() * 10.0f + 0.5f);
+    status.targetTenths = (uint16_t)(awning.getTargetPosition() * 10.0f + 0.5f);
+    unsigned long pulses = windSensor.getPulsesPerMinute();
+    status.windPulses = pulses > 0xFFFF ? 0xFFFF : (uint16_t)pulses;
+    status.flags = calibration.isActive() ? UDP_FLAG_CALIBRATING : 0;
+    return status;
+}
@@ -2,20 +2,40 @@
 #include <ArduinoJson.h>
 #include <ESP8266mDNS.h>
 #include "awning_controller.h"
+#include "motor_controller.h"
+#include "mqtt_handler.h"
 #include "position_tracker.h"
 #include "wind_sensor.h"
 #include "constants.h"
-#include "web_pages.h"
+#include "loop_stats.h"
+#include "loop_tasks.h"
+#include "boot_stages.h"
+#include "metrics_writer.h"
+#include "calibration_session.h"
+#include "udp_control.h"
+#include "web_assets.h"
+#include "web_templates.h"
+#include "html_stream.h"
+#include <lwip/priv/tcp_priv.h>
+#include <Updater.h>
 
 // External references to global objects from main.cpp
 extern AwningController awning;
 extern PositionTracker positionTracker;
 extern WindSensor windSensor;
-extern void saveSettings();
-extern void setTargetPosition(float targetPosition, const char* source);
+extern ControlCommandQueue controlCommands;
+extern LoopStats loopStats;
+extern MotorController motor;
+extern MqttHandler mqtt;
+extern volatile unsigned long windPulseCount;
+extern float travelSinceEndStop;
+extern CalibrationSession calibration;
+extern UdpControl udpControl;
+extern bool startCalibration(uint8_t runsPerDirection);
+extern void runSafetyTasks();
 
 WebInterface::WebInterface(ConfigManager* config) : server(80), configManager(config), 
-    calibrationInProgress(false), calibrationStartTime(0) {
+    lastEventKeepalive(0), restartPending(false), restartRequestedAt(0) {
 }
 
 void WebInterface::begin() {
@@ -25,15 +45,28 @@ void WebInterface::begin() {
     }
     
     // Setup routes
-    server.on("/", [this](){ handleRoot(); });
-    server.on("/control", HTTP_POST, [this](){ handleControl(); });
-    server.on("/status", HTTP_GET, [this](){ handleStatus(); });
-    server.on("/calibrate", HTTP_POST, [this](){ handleCalibrate(); });
-    server.on("/wind-config", HTTP_POST, [this](){ handleWindConfig(); });
-    server.on("/system-config", HTTP_GET, [this](){ handleSystemConfig(); });
-    server.on("/system-config", HTTP_POST, [this](){ handleSystemConfigSave(); });
-    server.on("/factory-reset", HTTP_POST, [this](){ handleFactoryReset(); });
-    server.onNotFound([this](){ handleNotFound(); });
+    // Only the small API calls polled by the page keep their connection
+    server.on("/", [this](){ beginRequest(false); handleRoot(); });
+    server.on("/control", HTTP_POST, [this](){ beginRequest(true); handleControl(); });
+    server.on("/status", HTTP_GET, [this](){ beginRequest(true); handleStatus(); });
+    server.on("/events", HTTP_GET, [this](){ beginRequest(false); handleEvents(); });
+    server.on("/diag", HTTP_GET, [this](){ beginRequest(true); handleDiagnostics(); });
+    server.on("/metrics", HTTP_GET, [this](){ beginRequest(true); handleMetrics(); });
+    server.on("/calibrate", HTTP_POST, [this](){ beginRequest(true); handleCalibrate(); });
+    server.on("/calibrate", HTTP_GET, [this](){ beginRequest(true); handleCalibrationResult(); });
+    server.on("/wind-config", HTTP_POST, [this](){ beginRequest(true); handleWindConfig(); });
+    server.on("/system-config", HTTP_GET, [this](){ beginRequest(false); handleSystemConfig(); });
+    server.on("/system-config", HTTP_POST, [this](){ beginRequest(false); handleSystemConfigSave(); });
+    server.on("/api/v2", HTTP_POST, [this](){ beginRequest(true); handleApiV2(); });
+    server.on("/update", HTTP_POST, [this](){ beginRequest(false); handleUpdate(); },
+              [this](){ handleUpdateUpload(); });
+    server.on("/update", HTTP_GET, [this](){ beginRequest(true); handleUpdateStatus(); });
+    server.on("/factory-reset", HTTP_POST, [this](){ beginRequest(false); handleFactoryReset(); });
+    server.onNotFound([this](){ beginRequest(false); handleNotFound(); });
+    
+    // Needed to answer conditional requests with 304
+    static const char* headerKeys[] = {"If-None-Match", "Connection", "Accept"};
+    server.collectHeaders(headerKeys, 3);
     
     server.begin();
     Serial.print("Web Interface: Started on http://");
@@ -42,14 +75,160 @@ void WebInterface::begin() {
 
 void WebInterface::loop() {
     server.handleClient();
+    serviceTransfers();
+    pushStatusEvents();
+    restartWhenIdle();
 }
 
 bool WebInterface::isRunning() const {
     return WiFi.isConnected();
 }
 
+// Counts the request's connection and decides whether it stays open. The
+// server works on one connection at a time and releases a kept one as soon
+// as another client connects, so holding it costs other browsers nothing.
+void WebInterface::beginRequest(bool persistent) {
+    WiFiClient& client = server.client();
+    connectionStats.record((uint32_t)client.remoteIP(), client.remotePort());
+    server.keepAlive(persistent && !server.header("Connection").equalsIgnoreCase("close"));
+}
+
+// Length of one of lwIP's PCB lists
+static int countTcpPcbs(const struct tcp_pcb* list) {
+    int count = 0;
+    for (; list; list = list->next) {
+        count++;
+    }
+    return count;
+}
+
 void WebInterface::handleRoot() {
-    server.send_P(200, "text/html", HTML_INDEX);
+    sendGzipAsset(INDEX_HTML_TYPE, INDEX_HTML_GZ, INDEX_HTML_GZ_LEN, INDEX_HTML_ETAG);
+}
+
+void WebInterface::sendGzipAsset(const char* contentType, const uint8_t* data, size_t length, const char* etag) {
+    // Revalidate on every load so a firmware update shows up at once;
+    // an unchanged page then costs a header-only 304. Headers are queued on
+    // the server only when it sends the response: a detached client gets
+    // them written by hand, and queued ones would go out with the next reply.
+    if (server.header("If-None-Match") == etag) {
+        server.sendHeader("ETag", etag);
+        server.sendHeader("Cache-Control", "no-cache");
+        server.send(304);
+        return;
+    }
+    
+    WebTransfer* transfer = freeTransfer();
+    if (!transfer) {
+        // All slots busy: answer inline, the page still arrives intact
+        server.sendHeader("ETag", etag);
+        server.sendHeader("Cache-Control", "no-cache");
+        server.sendHeader("Content-Encoding", "gzip");
+        server.send_P(200, contentType, (PGM_P)data, length);
+        return;
+    }
+    
+    transfer->client = detachClient();
+    transfer->client.printf("HTTP/1.1 200 OK\r\n"
+                            "Content-Type: %s\r\n"
+                            "Content-Encoding: gzip\r\n"
+                            "Content-Length: %u\r\n"
+                            "ETag: %s\r\n"
+                            "Cache-Control: no-cache\r\n"
+                            "Connection: close\r\n\r\n",
+                            contentType, (unsigned)length, etag);
+    transfer->data = (PGM_P)data;
+    transfer->length = length;
+    transfer->position = 0;
+    transfer->isTemplate = false;
+    transfer->lastProgress = millis();
+}
+
+// Takes the current connection away from the server so it can be written
+// from loop(); the server lets go of it once the handler returns
+WiFiClient WebInterface::detachClient() {
+    server.keepAlive(false);
+    WiFiClient client = server.client();
+    // Writes must return at once instead of waiting for the ACK
+    client.setSync(false);
+    return client;
+}
+
+WebTransfer* WebInterface::freeTransfer() {
+    for (int i = 0; i < WEB_MAX_TRANSFERS; i++) {
+        if (!transfers[i].client.connected()) {
+            return &transfers[i];
+        }
+    }
+    return nullptr;
+}
+
+int WebInterface::activeTransfers() {
+    int active = 0;
+    for (int i = 0; i < WEB_MAX_TRANSFERS; i++) {
+        if (transfers[i].client.connected()) {
+            active++;
+        }
+    }
+    return active;
+}
+
+void WebInterface::serviceTransfers() {
+    unsigned long now = millis();
+    for (int i = 0; i < WEB_MAX_TRANSFERS; i++) {
+        WebTransfer& transfer = transfers[i];
+        if (!transfer.client.connected()) {
+            continue;
+        }
+        
+        bool finished = transfer.isTemplate ? serviceTemplate(transfer) : serviceAsset(transfer);
+        if (finished || now - transfer.lastProgress >= WEB_TRANSFER_TIMEOUT_MS) {
+            // Releasing the last reference closes gracefully after queued data
+            transfer.client = WiFiClient();
+        }
+    }
+}
+
+// Returns true once the whole asset is queued
+bool WebInterface::serviceAsset(WebTransfer& transfer) {
+    size_t room = transfer.client.availableForWrite();
+    size_t remaining = transfer.length - transfer.position;
+    size_t count = room < remaining ? room : remaining;
+    if (count > 0) {
+        transfer.client.write_P(transfer.data + transfer.position, count);
+        transfer.position += count;
+        transfer.lastProgress = millis();
+    }
+    return transfer.position >= transfer.length;
+}
+
+// Renders one chunk when the send buffer can take it whole.
+// Returns true after the terminating chunk is queued.
+bool WebInterface::serviceTemplate(WebTransfer& transfer) {
+    // A long escaped value can complete a second chunk in the same step
+    if ((size_t)transfer.client.availableForWrite() < 2 * (HTML_STREAM_CHUNK_SIZE + 8)) {
+        return false;
+    }
+    
+    WiFiClient& client = transfer.client;
+    auto sink = [&client](const char* data, size_t length) {
+        client.printf("%x\r\n", (unsigned)length);
+        client.write((const uint8_t*)data, length);
+        client.print(F("\r\n"));
+    };
+    auto resolve = [this](const char* name, char* scratch, size_t scratchSize) {
+        return resolveConfigPlaceholder(*configManager, name, scratch, scratchSize);
+    };
+    PGM_P page = transfer.data;
+    bool done = false;
+    transfer.position = transfer.writer.renderStep([page](size_t i) { return (char)pgm_read_byte(page + i); },
+                                                   resolve, sink, transfer.position, done);
+    transfer.lastProgress = millis();
+    
+    if (done) {
+        client.print(F("0\r\n\r\n"));
+    }
+    return done;
 }
 
 void WebInterface::handleControl() {
@@ -60,19 +239,17 @@ void WebInterface::handleControl() {
 
     String action = server.arg("action");
 
+    bool queued;
     if (action == "open") {
-        setTargetPosition(100.0, "Web");
+        queued = queueControl(CONTROL_SET_TARGET, 100.0, "Web");
     } else if (action == "close") {
-        setTargetPosition(0.0, "Web");
+        queued = queueControl(CONTROL_SET_TARGET, 0.0, "Web");
     } else if (action == "stop") {
-        // Use last movement relay for web stop
-        awning.stop(awning.getLastMovementRelay());
-        saveSettings();
-        Serial.println("Web: Command STOP");
+        queued = queueControl(CONTROL_STOP, 0.0, "Web");
     } else if (action == "position" && server.hasArg("value")) {
         float position = server.arg("value").toFloat();
         if (position >= 0.0 && position <= 100.0) {
-            setTargetPosition(position, "Web");
+            queued = queueControl(CONTROL_SET_TARGET, position, "Web");
         } else {
             server.send(400, "text/plain", "Invalid position value");
             return;
@@ -82,47 +259,167 @@ void WebInterface::handleControl() {
         return;
     }
 
+    if (!queued) {
+        server.send(503, "text/plain", "Busy, try again");
+        return;
+    }
     server.send(200, "text/plain", "OK");
 }
 
+// Motor commands are applied by the main loop, never inside a request
+bool WebInterface::queueControl(ControlCommandType type, float position, const char* source) {
+    ControlCommand command = {type, position, source};
+    return controlCommands.push(command);
+}
+
 void WebInterface::handleStatus() {
-    server.send(200, "application/json", getStatusJson());
+    // Pollers of an unchanged state get the cached bytes, sent without a copy
+    server.sendHeader("Vary", "Accept");
+    size_t length;
+    if (server.header("Accept").indexOf("application/cbor") >= 0) {
+        const uint8_t* cbor = statusCache.getCbor(getStatusSnapshot(), length);
+        server.send(200, "application/cbor", (const char*)cbor, length);
+        return;
+    }
+    const char* json = statusCache.getJson(getStatusSnapshot(), length);
+    server.send(200, "application/json", json, length);
 }
 
-void WebInterface::handleCalibrate() {
-    if (!calibrationInProgress) {
-        // Start calibration
-        if (awning.getCurrentPosition() > 5.0) {
-            server.send(400, "text/plain", "Awning must be at 0% position to start calibration");
-            return;
+void WebInterface::handleEvents() {
+    int slot = -1;
+    for (int i = 0; i < WEB_EVENTS_MAX_CLIENTS; i++) {
+        if (!eventClients[i].connected()) {
+            slot = i;
+            break;
         }
+    }
+    
+    // Browsers fall back to polling /status when the stream is refused
+    if (slot < 0) {
+        server.send(503, "text/plain", "Too many event clients");
+        return;
+    }
+    
+    // The copy keeps the connection open after the server is done with it
+    WiFiClient client = detachClient();
+    client.setNoDelay(true);
+    client.print(F("HTTP/1.1 200 OK\r\n"
+                   "Content-Type: text/event-stream\r\n"
+                   "Cache-Control: no-cache\r\n"
+                   "Connection: keep-alive\r\n\r\n"
+                   "retry: 2000\n\n"));
+    
+    size_t length;
+    const char* data = statusCache.getJson(getStatusSnapshot(), length);
+    if (length > 0) {
+        sendEvent(client, data);
+    }
+    
+    eventClients[slot] = client;
+    Serial.print("Web: Event client connected from ");
+    Serial.println(client.remoteIP());
+}
 
-        calibrationInProgress = true;
-        calibrationStartTime = millis();
-        setTargetPosition(100.0, "Calibration");
-
-        Serial.println("Web: Calibration started - awning extending");
-        server.send(200, "text/plain", "Calibration started");
-    } else {
-        // Stop calibration and calculate travel time
-        unsigned long travelTime = millis() - calibrationStartTime;
-
-        // Stop motor immediately
-        awning.stop(awning.getLastMovementRelay());
-
-        // Set the measured travel time
-        configManager->setTravelTime(travelTime);
-        positionTracker.setTravelTime(travelTime);
-        configManager->save();
+bool WebInterface::sendEvent(WiFiClient& client, const char* data) {
+    char frame[220];
+    int len = snprintf(frame, sizeof(frame), "event: status\ndata: %s\n\n", data);
+    if (len <= 0 || len >= (int)sizeof(frame)) {
+        return false;
+    }
+    
+    // Never block the control loop on a client that stopped reading
+    if (client.availableForWrite() < len) {
+        client.stop();
+        return false;
+    }
+    return client.write((const uint8_t*)frame, len) == (size_t)len;
+}
 
-        calibrationInProgress = false;
+void WebInterface::pushStatusEvents() {
+    bool anyClient = false;
+    for (int i = 0; i < WEB_EVENTS_MAX_CLIENTS; i++) {
+        if (eventClients[i].connected()) {
+            anyClient = true;
+        } else {
+            eventClients[i].stop();
+        }
+    }
+    
+    if (!anyClient) {
+        statusDelta.reset();
+        return;
+    }
+    
+    unsigned long now = millis();
+    StatusSnapshot status = getStatusSnapshot();
+    if (statusDelta.isDue(now, status, WEB_EVENTS_MOTION_INTERVAL_MS, WEB_EVENTS_IDLE_INTERVAL_MS)) {
+        char data[WEB_STATUS_JSON_SIZE];
+        if (statusDelta.encodeDelta(status, now, data, sizeof(data)) > 0) {
+            for (int i = 0; i < WEB_EVENTS_MAX_CLIENTS; i++) {
+                if (eventClients[i].connected()) {
+                    sendEvent(eventClients[i], data);
+                }
+            }
+            lastEventKeepalive = now;
+        }
+    }
+    
+    if (now - lastEventKeepalive >= WEB_EVENTS_KEEPALIVE_MS) {
+        for (int i = 0; i < WEB_EVENTS_MAX_CLIENTS; i++) {
+            if (eventClients[i].connected()) {
+                eventClients[i].print(F(": ping\n\n"));
+            }
+        }
+        lastEventKeepalive = now;
+    }
+}
 
-        Serial.print("Web: Calibration completed - travel time set to ");
-        Serial.print(travelTime);
-        Serial.println(" ms");
+// Starts or cancels a calibration. Runs are timed on the device from relay
+// activation to a wall button press, so request latency plays no part.
+void WebInterface::handleCalibrate() {
+    if (calibration.isActive()) {
+        calibration.cancel();
+        queueControl(CONTROL_STOP, 0.0, "Calibration");
+        Serial.println("Web: Calibration cancelled");
+        server.send(200, "text/plain", "Calibration cancelled");
+        return;
+    }
+    
+    long runs = server.hasArg("runs") ? server.arg("runs").toInt() : 1;
+    if (runs < 1 || runs > CalibrationSession::MAX_RUNS_PER_DIRECTION) {
+        server.send(400, "text/plain", "Invalid number of runs");
+        return;
+    }
+    if (!startCalibration((uint8_t)runs)) {
+        server.send(400, "text/plain", "Awning must be at 0% position to start calibration");
+        return;
+    }
+    server.send(200, "text/plain", "Calibration started");
+}
 
-        server.send(200, "text/plain", "Calibration completed");
+// Progress and the per-direction statistics of the last calibration
+void WebInterface::handleCalibrationResult() {
+    StaticJsonDocument<JSON_OBJECT_SIZE(8) + 2 * JSON_OBJECT_SIZE(4)> doc;
+    doc["active"] = calibration.isActive();
+    doc["completed"] = calibration.isCompleted();
+    doc["direction"] = calibration.getDirection() == CALIBRATE_EXTEND ? "extend" : "retract";
+    doc["runsPerDirection"] = calibration.getRunsPerDirection();
+    doc["completedRuns"] = calibration.getCompletedRuns();
+    doc["travelTime"] = calibration.getTravelTime();
+    
+    const TravelTimeStats* stats[] = {&calibration.getExtendStats(), &calibration.getRetractStats()};
+    const char* names[] = {"extend", "retract"};
+    for (int i = 0; i < 2; i++) {
+        JsonObject direction = doc.createNestedObject(names[i]);
+        direction["runs"] = stats[i]->getCount();
+        direction["meanMs"] = (unsigned long)(stats[i]->getMean() + 0.5);
+        direction["stddevMs"] = (unsigned long)(stats[i]->getStdDev() + 0.5);
+        direction["varianceMs2"] = (unsigned long)(stats[i]->getVariance() + 0.5);
     }
+    
+    char json[320];
+    serializeJson(doc, json, sizeof(json));
+    server.send(200, "application/json", json);
 }
 
 void WebInterface::handleWindConfig() {
@@ -148,144 +445,293 @@ void WebInterface::handleWindConfig() {
     }
 }
 
-void WebInterface::handleSystemConfig() {
-    String html = R"rawliteral(
-<!DOCTYPE html>
-<html>
-<head>
-    <title>System Configuration</title>
-    <meta name="viewport" content="width=device-width, initial-scale=1">
-    <style>
-        body { font-family: Arial, sans-serif; margin: 20px; background: #f0f0f0; }
-        .container { max-width: 600px; margin: 0 auto; background: white; padding: 20px; border-radius: 10px; }
-        h1 { color: #333; text-align: center; }
-        .section { margin: 20px 0; padding: 15px; border: 1px solid #ddd; border-radius: 5px; }
-        .form-group { margin: 10px 0; }
-        label { display: inline-block; width: 150px; font-weight: bold; }
-        input[type="text"], input[type="password"], input[type="number"] { 
-            width: 200px; padding: 5px; border: 1px solid #ddd; border-radius: 4px; 
+// Restart mDNS with a new hostname if currently running
+static void restartMdns(const char* hostname) {
+    if (!MDNS.isRunning()) {
+        return;
+    }
+    MDNS.end();
+    if (MDNS.begin(hostname)) {
+        MDNS.addService("http", "tcp", 80);
+        MDNS.addServiceTxt("http", "tcp", "device", "sonnensegel");
+        MDNS.addServiceTxt("http", "tcp", "version", "1.0");
+        Serial.printf("mDNS: Restarted with new hostname '%s.local'\n", hostname);
+    } else {
+        Serial.println("mDNS: Failed to restart with new hostname");
+    }
+}
+
+// Returns the first key of object not in allowed, so typos are not ignored
+static const char* findUnknownKey(JsonObjectConst object, const char* const* allowed, size_t count) {
+    for (JsonPairConst field : object) {
+        bool known = false;
+        for (size_t i = 0; i < count && !known; i++) {
+            known = strcmp(field.key().c_str(), allowed[i]) == 0;
         }
-        button { 
-            background: #FF9800; color: white; padding: 8px 16px; 
-            border: none; border-radius: 4px; cursor: pointer; margin: 5px; 
+        if (!known) {
+            return field.key().c_str();
         }
-        button:hover { background: #F57C00; }
-        .nav { text-align: center; margin-bottom: 20px; }
-        .nav a { margin: 0 10px; color: #2196F3; text-decoration: none; }
-    </style>
-</head>
-<body>
-    <div class="container">
-        <div class="nav">
-            <a href="/">Back to Control</a>
-        </div>
-        
-        <h1>System Configuration</h1>
-        
-        <form method="POST" action="/system-config">
-            <div class="section">
-                <h3>WiFi Settings</h3>
-                <div class="form-group">
-                    <label>WiFi SSID:</label>
-                    <input type="text" name="wifi_ssid" value=")rawliteral" + 
-                    String(configManager->getWiFiSSID()) + R"rawliteral(">
-                </div>
-                <div class="form-group">
-                    <label>WiFi Password:</label>
-                    <input type="password" name="wifi_password" placeholder="Enter new password">
-                </div>
-                <div class="form-group">
-                    <label>Hostname:</label>
-                    <input type="text" name="hostname" value=")rawliteral" + 
-                    String(configManager->getHostname()) + R"rawliteral(" maxlength="31">
-                </div>
-            </div>
-            
-            <div class="section">
-                <h3>MQTT Settings</h3>
-                <div class="form-group">
-                    <label>
-                        <input type="checkbox" name="mqtt_enabled" value="1" )rawliteral" + 
-                        String(configManager->isMQTTEnabled() ? "checked" : "") + R"rawliteral(> 
-                        Enable MQTT Integration
-                    </label>
-                </div>
-                <div class="form-group">
-                    <label>MQTT Server:</label>
-                    <input type="text" name="mqtt_server" value=")rawliteral" + 
-                    String(configManager->getMQTTServer()) + R"rawliteral(">
-                </div>
-                <div class="form-group">
-                    <label>MQTT Port:</label>
-                    <input type="number" name="mqtt_port" value=")rawliteral" + 
-                    String(configManager->getMQTTPort()) + R"rawliteral(">
-                </div>
-                <div class="form-group">
-                    <label>MQTT Username:</label>
-                    <input type="text" name="mqtt_username" value=")rawliteral" + 
-                    String(configManager->getMQTTUsername()) + R"rawliteral(">
-                </div>
-                <div class="form-group">
-                    <label>MQTT Password:</label>
-                    <input type="password" name="mqtt_password" placeholder="Enter new password">
-                </div>
-                <div class="form-group">
-                    <label>Client ID:</label>
-                    <input type="text" name="mqtt_client_id" value=")rawliteral" + 
-                    String(configManager->getMQTTClientId()) + R"rawliteral(">
-                </div>
-                <div class="form-group">
-                    <label>Base Topic:</label>
-                    <input type="text" name="mqtt_base_topic" value=")rawliteral" + 
-                    String(configManager->getMQTTBaseTopic()) + R"rawliteral(">
-                </div>
-            </div>
-            
-            <div style="text-align: center;">
-                <button type="submit">Save Configuration</button>
-            </div>
-        </form>
-        
-        <div style="text-align: center; margin-top: 30px; padding-top: 20px; border-top: 1px solid #ddd;">
-            <h3 style="color: #f44336;">Danger Zone</h3>
-            <p style="font-size: 14px; color: #666; margin: 10px 0;">
-                Factory reset will erase all WiFi, MQTT, and awning settings. The device will restart.
-            </p>
-            <button type="button" onclick="factoryReset()" 
-                    style="background: #f44336; color: white; padding: 10px 20px; border: none; border-radius: 4px; cursor: pointer;">
-                Factory Reset
-            </button>
-        </div>
-    </div>
+    }
+    return nullptr;
+}
+
+// Absent, or a string that fits a config field of the given size
+static bool fitsField(JsonVariantConst value, size_t size) {
+    return value.isNull() || (value.is<const char*>() && strlen(value.as<const char*>()) < size);
+}
+
+static bool inRange(JsonVariantConst value, float low, float high) {
+    if (value.isNull()) {
+        return true;
+    }
+    if (!value.is<float>()) {
+        return false;
+    }
+    float number = value.as<float>();
+    return number >= low && number <= high;
+}
+
+// Integer fields read back through as<unsigned long>() or a uint16_t default,
+// which would silently truncate or drop a fractional value
+static bool isIntegerOrAbsent(JsonVariantConst value) {
+    return value.isNull() || value.is<long>();
+}
+
+static bool isBoolOrAbsent(JsonVariantConst value) {
+    return value.isNull() || value.is<bool>();
+}
+
+void WebInterface::sendApiError(int code, const char* error, const char* field) {
+    char json[96];
+    if (field) {
+        snprintf(json, sizeof(json), "{\"ok\":false,\"error\":\"%s\",\"field\":\"%.40s\"}", error, field);
+    } else {
+        snprintf(json, sizeof(json), "{\"ok\":false,\"error\":\"%s\"}", error);
+    }
+    server.send(code, "application/json", json);
+}
+
+// POST /api/v2: several operations in one JSON object, e.g.
+// {"position":50,"windThreshold":120,"mqtt":{"enabled":true,"port":1883}}
+// Every field is validated before anything is applied, and all config
+// changes are committed with a single save().
+void WebInterface::handleApiV2() {
+    static const char* const TOP_KEYS[] = {"action", "position", "windThreshold", "travelTime",
+                                           "hostname", "wifi", "mqtt"};
+    static const char* const WIFI_KEYS[] = {"ssid", "password"};
+    static const char* const MQTT_KEYS[] = {"enabled", "server", "port", "username", "password", "clientId",
+                                            "baseTopic", "persistentSession", "jsonState", "tls",
+                                            "tlsFingerprint", "secondaryServer", "secondaryPort"};
     
-    <script>
-        function factoryReset() {
-            if (confirm('WARNING: This will erase ALL settings and restart the device.\\n\\nAre you sure you want to continue?')) {
-                if (confirm('This action cannot be undone. Continue with factory reset?')) {
-                    fetch('/factory-reset', { method: 'POST' })
-                        .then(response => {
-                            if (response.ok) {
-                                alert('Factory reset initiated. Device will restart in a few seconds...');
-                                setTimeout(() => {
-                                    window.location.href = '/';
-                                }, 3000);
-                            } else {
-                                alert('Factory reset failed. Please try again.');
-                            }
-                        })
-                        .catch(error => {
-                            console.error('Reset failed:', error);
-                            alert('Factory reset failed. Please try again.');
-                        });
-                }
-            }
+    if (!server.hasArg("plain")) {
+        sendApiError(400, "empty", nullptr);
+        return;
+    }
+    
+    // Parsed in place: strings in the document point into the body
+    String body = server.arg("plain");
+    StaticJsonDocument<JSON_OBJECT_SIZE(7) + JSON_OBJECT_SIZE(2) + JSON_OBJECT_SIZE(13)> doc;
+    DeserializationError error = deserializeJson(doc, body.begin(), body.length());
+    if (error) {
+        sendApiError(error == DeserializationError::NoMemory ? 413 : 400,
+                     error == DeserializationError::NoMemory ? "too_large" : "invalid_json", nullptr);
+        return;
+    }
+    JsonObjectConst ops = doc.as<JsonObjectConst>();
+    if (ops.isNull() || ops.size() == 0) {
+        sendApiError(400, "empty", nullptr);
+        return;
+    }
+    
+    JsonObjectConst wifi = ops["wifi"];
+    JsonObjectConst mqtt = ops["mqtt"];
+    if (!ops["wifi"].isNull() && wifi.isNull()) {
+        sendApiError(400, "invalid_type", "wifi");
+        return;
+    }
+    if (!ops["mqtt"].isNull() && mqtt.isNull()) {
+        sendApiError(400, "invalid_type", "mqtt");
+        return;
+    }
+    const char* unknown = findUnknownKey(ops, TOP_KEYS, sizeof(TOP_KEYS) / sizeof(TOP_KEYS[0]));
+    if (!unknown && !wifi.isNull()) {
+        unknown = findUnknownKey(wifi, WIFI_KEYS, sizeof(WIFI_KEYS) / sizeof(WIFI_KEYS[0]));
+    }
+    if (!unknown && !mqtt.isNull()) {
+        unknown = findUnknownKey(mqtt, MQTT_KEYS, sizeof(MQTT_KEYS) / sizeof(MQTT_KEYS[0]));
+    }
+    if (unknown) {
+        sendApiError(400, "unknown_field", unknown);
+        return;
+    }
+    
+    // Validate
+    if (!fitsField(ops["action"], 8)) {
+        sendApiError(400, "invalid_value", "action");
+        return;
+    }
+    const char* action = ops["action"] | (const char*)nullptr;
+    if (action && strcmp(action, "open") != 0 && strcmp(action, "close") != 0 && strcmp(action, "stop") != 0) {
+        sendApiError(400, "invalid_value", "action");
+        return;
+    }
+    if (action && !ops["position"].isNull()) {
+        sendApiError(400, "conflict", "position");
+        return;
+    }
+    struct RangeCheck { JsonVariantConst value; float low; float high; const char* name; };
+    const RangeCheck ranges[] = {
+        {ops["position"], MIN_POSITION, MAX_POSITION, "position"},
+        {ops["windThreshold"], MIN_WIND_PULSE_THRESHOLD, MAX_WIND_PULSE_THRESHOLD, "windThreshold"},
+        {ops["travelTime"], MIN_TRAVEL_TIME_MS, MAX_TRAVEL_TIME_MS, "travelTime"},
+        {mqtt["port"], 1, 65535, "mqtt.port"},
+        {mqtt["secondaryPort"], 0, 65535, "mqtt.secondaryPort"},
+    };
+    for (const RangeCheck& check : ranges) {
+        if (!inRange(check.value, check.low, check.high)) {
+            sendApiError(400, "out_of_range", check.name);
+            return;
         }
-    </script>
-</body>
-</html>
-)rawliteral";
+    }
+    // Everything but the position is stored as an integer
+    for (size_t i = 1; i < sizeof(ranges) / sizeof(ranges[0]); i++) {
+        if (!isIntegerOrAbsent(ranges[i].value)) {
+            sendApiError(400, "invalid_value", ranges[i].name);
+            return;
+        }
+    }
+    struct FieldCheck { JsonVariantConst value; size_t size; const char* name; };
+    const FieldCheck fields[] = {
+        {ops["hostname"], sizeof(WiFiConfig::hostname), "hostname"},
+        {wifi["ssid"], sizeof(WiFiConfig::ssid), "wifi.ssid"},
+        {wifi["password"], sizeof(WiFiConfig::password), "wifi.password"},
+        {mqtt["server"], sizeof(MQTTConfig::server), "mqtt.server"},
+        {mqtt["username"], sizeof(MQTTConfig::username), "mqtt.username"},
+        {mqtt["password"], sizeof(MQTTConfig::password), "mqtt.password"},
+        {mqtt["clientId"], sizeof(MQTTConfig::clientId), "mqtt.clientId"},
+        {mqtt["baseTopic"], sizeof(MQTTConfig::baseTopic), "mqtt.baseTopic"},
+        {mqtt["tlsFingerprint"], sizeof(MQTTConfig::tlsFingerprint), "mqtt.tlsFingerprint"},
+        {mqtt["secondaryServer"], sizeof(MQTTConfig::secondaryServer), "mqtt.secondaryServer"},
+    };
+    for (const FieldCheck& check : fields) {
+        if (!fitsField(check.value, check.size)) {
+            sendApiError(400, "invalid_value", check.name);
+            return;
+        }
+    }
+    const char* hostname = ops["hostname"] | (const char*)nullptr;
+    if (hostname && hostname[0] == '\0') {
+        sendApiError(400, "invalid_value", "hostname");
+        return;
+    }
+    const char* ssid = wifi["ssid"] | (const char*)nullptr;
+    if (ssid && ssid[0] == '\0') {
+        sendApiError(400, "invalid_value", "wifi.ssid");
+        return;
+    }
+    static const char* const BOOL_KEYS[] = {"enabled", "persistentSession", "jsonState", "tls"};
+    for (const char* name : BOOL_KEYS) {
+        if (!isBoolOrAbsent(mqtt[name])) {
+            sendApiError(400, "invalid_type", name);
+            return;
+        }
+    }
+    
+    // A full command queue refuses the request before anything changes
+    bool hasMotorCommand = action || !ops["position"].isNull();
+    ControlCommand motorCommand = {CONTROL_STOP, 0.0f, "API"};
+    if (action && strcmp(action, "stop") != 0) {
+        motorCommand = {CONTROL_SET_TARGET, strcmp(action, "open") == 0 ? 100.0f : 0.0f, "API"};
+    } else if (!action && hasMotorCommand) {
+        motorCommand = {CONTROL_SET_TARGET, ops["position"].as<float>(), "API"};
+    }
+    if (hasMotorCommand && !controlCommands.canAccept(motorCommand)) {
+        sendApiError(503, "busy", nullptr);
+        return;
+    }
+    
+    // Apply config changes and save them; the motor command is queued only
+    // after a successful save, so a failed request leaves the motor alone
+    int applied = 0;
+    bool persist = false;
+    if (!ops["windThreshold"].isNull()) {
+        unsigned long threshold = ops["windThreshold"].as<unsigned long>();
+        configManager->setWindThreshold(threshold);
+        windSensor.setThreshold(threshold);
+        persist = true;
+        applied++;
+    }
+    if (!ops["travelTime"].isNull()) {
+        unsigned long travelTime = ops["travelTime"].as<unsigned long>();
+        configManager->setTravelTime(travelTime);
+        positionTracker.setTravelTime(travelTime);
+        persist = true;
+        applied++;
+    }
+    if (hostname && strcmp(hostname, configManager->getHostname()) != 0) {
+        configManager->setHostname(hostname);
+        restartMdns(hostname);
+        persist = true;
+        applied++;
+    }
+    if (!wifi.isNull()) {
+        configManager->setWiFiCredentials(ssid ? ssid : configManager->getWiFiSSID(),
+                                          wifi["password"] | configManager->getWiFiPassword());
+        persist = true;
+        applied++;
+    }
+    if (!mqtt.isNull()) {
+        configManager->setMQTTEnabled(mqtt["enabled"] | configManager->isMQTTEnabled());
+        configManager->setMQTTPersistentSession(mqtt["persistentSession"] | configManager->isMQTTPersistentSession());
+        configManager->setMQTTJsonState(mqtt["jsonState"] | configManager->isMQTTJsonState());
+        configManager->setMQTTTls(mqtt["tls"] | configManager->isMQTTTlsEnabled(),
+                                  mqtt["tlsFingerprint"] | configManager->getMQTTTlsFingerprint());
+        configManager->setMQTTSecondaryBroker(mqtt["secondaryServer"] | configManager->getMQTTSecondaryServer(),
+                                              mqtt["secondaryPort"] | configManager->getMQTTSecondaryPort());
+        configManager->setMQTTConfig(mqtt["server"] | configManager->getMQTTServer(),
+                                     mqtt["port"] | configManager->getMQTTPort(),
+                                     mqtt["username"] | configManager->getMQTTUsername(),
+                                     mqtt["password"] | configManager->getMQTTPassword(),
+                                     mqtt["clientId"] | configManager->getMQTTClientId(),
+                                     mqtt["baseTopic"] | configManager->getMQTTBaseTopic());
+        persist = true;
+        applied++;
+    }
+    
+    if (persist && !configManager->save()) {
+        sendApiError(500, "save_failed", nullptr);
+        return;
+    }
+    if (hasMotorCommand) {
+        controlCommands.push(motorCommand);
+        applied++;
+    }
     
-    server.send(200, "text/html", html);
+    char json[64];
+    snprintf(json, sizeof(json), "{\"ok\":true,\"applied\":%d,\"saved\":%s}", applied, persist ? "true" : "false");
+    server.send(200, "application/json", json);
+}
+
+void WebInterface::handleSystemConfig() {
+    WebTransfer* transfer = freeTransfer();
+    if (transfer) {
+        transfer->client = detachClient();
+        transfer->client.print(F("HTTP/1.1 200 OK\r\n"
+                                 "Content-Type: text/html\r\n"
+                                 "Transfer-Encoding: chunked\r\n"
+                                 "Connection: close\r\n\r\n"));
+        transfer->data = SYSTEM_CONFIG_TEMPLATE;
+        transfer->length = 0;
+        transfer->position = 0;
+        transfer->isTemplate = true;
+        transfer->writer = HtmlTemplateWriter<HTML_STREAM_CHUNK_SIZE>();
+        transfer->lastProgress = millis();
+        return;
+    }
+    
+    streamHtmlTemplate(server, SYSTEM_CONFIG_TEMPLATE, [this](const char* name, char* scratch, size_t scratchSize) {
+        return resolveConfigPlaceholder(*configManager, name, scratch, scratchSize);
+    });
 }
 
 void WebInterface::handleSystemConfigSave() {
@@ -310,18 +756,7 @@ void WebInterface::handleSystemConfigSave() {
             configManager->setHostname(newHostname.c_str());
             wifiChanged = true;
             
-            // Restart mDNS with new hostname if currently running
-            if (MDNS.isRunning()) {
-                MDNS.end();
-                if (MDNS.begin(newHostname.c_str())) {
-                    MDNS.addService("http", "tcp", 80);
-                    MDNS.addServiceTxt("http", "tcp", "device", "sonnensegel");
-                    MDNS.addServiceTxt("http", "tcp", "version", "1.0");
-                    Serial.printf("mDNS: Restarted with new hostname '%s.local'\n", newHostname.c_str());
-                } else {
-                    Serial.println("mDNS: Failed to restart with new hostname");
-                }
-            }
+            restartMdns(newHostname.c_str());
         }
     }
     
@@ -330,6 +765,11 @@ void WebInterface::handleSystemConfigSave() {
         // Check if MQTT is enabled
         bool mqttEnabled = server.hasArg("mqtt_enabled");
         configManager->setMQTTEnabled(mqttEnabled);
+        configManager->setMQTTPersistentSession(server.hasArg("mqtt_persistent"));
+        configManager->setMQTTTls(server.hasArg("mqtt_tls"), server.arg("mqtt_tls_fingerprint").c_str());
+        configManager->setMQTTJsonState(server.hasArg("mqtt_json_state"));
+        configManager->setMQTTSecondaryBroker(server.arg("mqtt_secondary_server").c_str(),
+                                              server.arg("mqtt_secondary_port").toInt());
         
         String server_addr = server.arg("mqtt_server");
         uint16_t port = server.arg("mqtt_port").toInt();
@@ -424,29 +864,319 @@ void WebInterface::handleFactoryReset() {
     ESP.restart();
 }
 
-void WebInterface::handleNotFound() {
-    server.send(404, "text/plain", "Not Found");
+// The MD5 only guards against corruption, so an image is accepted only from
+// a client that knows the build's OTA password
+bool WebInterface::isOtaAuthorized() {
+    return strlen(OTA_PASSWORD) > 0 && server.authenticate(OTA_USERNAME, OTA_PASSWORD);
+}
+
+// Receives a firmware image from a multipart POST /update?md5=<hex>[&size=<bytes>]
+// and streams it into the spare flash area chunk by chunk. The server reads
+// the whole upload inside one handleClient() call, so the safety tasks are
+// run after every chunk. The Updater checks the image header and MD5 before
+// the bootloader is told to install it; the running firmware is untouched
+// until then.
+void WebInterface::handleUpdateUpload() {
+    HTTPUpload& upload = server.upload();
+    unsigned long now = millis();
+
+    switch (upload.status) {
+        case UPLOAD_FILE_START: {
+            // Nothing is written; handleUpdate() answers with the challenge
+            if (!isOtaAuthorized()) {
+                return;
+            }
+            uint32_t size = server.arg("size").toInt();
+            String md5 = server.arg("md5");
+            ota.begin(now, size);
+            if (!OtaSession::isValidMd5(md5.c_str())) {
+                ota.fail("invalid_md5", now);
+                return;
+            }
+
+            // An update ends with a reboot; ride out a windy spell retracted
+            unsigned long threshold = windSensor.getThreshold();
+            bool windy = windSensor.isSafetyTriggered() ||
+                         (threshold > 0 && windSensor.getPulsesPerMinute() * 100 > threshold * OTA_WIND_RETRACT_PERCENT);
+            if (windy && awning.getCurrentPosition() > MIN_POSITION) {
+                queueControl(CONTROL_SET_TARGET, MIN_POSITION, "OTA");
+                ota.fail("wind_retracting", now);
+                return;
+            }
+
+            uint32_t maxSize = (ESP.getFreeSketchSpace() - 0x1000) & 0xFFFFF000;
+            if (size > maxSize) {
+                ota.fail("too_large", now);
+                return;
+            }
+            if (!Update.begin(size > 0 ? size : maxSize)) {
+                Update.printError(Serial);
+                ota.fail("begin_failed", now);
+                return;
+            }
+            Update.setMD5(md5.c_str());
+            Serial.printf("OTA: Receiving %s (%u bytes announced)\n", upload.filename.c_str(), (unsigned)size);
+            break;
+        }
+
+        case UPLOAD_FILE_WRITE:
+            if (!ota.isActive()) {
+                return;
+            }
+            if (Update.write(upload.buf, upload.currentSize) != upload.currentSize) {
+                Update.printError(Serial);
+                ota.fail("write_failed", now);
+                Update.end();
+                return;
+            }
+            ota.onData(upload.currentSize, now);
+            runSafetyTasks();
+            ota.onSafetyTick(micros());
+            break;
+
+        case UPLOAD_FILE_END:
+            if (!ota.isActive()) {
+                return;
+            }
+            // Without an announced size the image ends wherever the upload does
+            if (Update.end(ota.getExpectedSize() == 0)) {
+                ota.succeed(now);
+            } else {
+                Update.printError(Serial);
+                ota.fail(Update.getError() == UPDATE_ERROR_MD5 ? "md5_mismatch" : "verify_failed", now);
+            }
+            break;
+
+        case UPLOAD_FILE_ABORTED:
+            if (ota.isActive()) {
+                Update.end();
+                ota.fail("aborted", now);
+            }
+            break;
+    }
 }
 
+// Final response to POST /update, sent after the upload handler saw the
+// whole body
+void WebInterface::handleUpdate() {
+    if (strlen(OTA_PASSWORD) == 0) {
+        sendApiError(403, "ota_disabled", nullptr);
+        return;
+    }
+    if (!isOtaAuthorized()) {
+        server.requestAuthentication(DIGEST_AUTH, OTA_REALM);
+        return;
+    }
+    
+    OtaState state = ota.getState();
+    if (state == OTA_SUCCEEDED) {
+        const LoopStats& gaps = ota.getSafetyGaps();
+        char json[160];
+        snprintf(json, sizeof(json),
+                 "{\"ok\":true,\"bytes\":%lu,\"ms\":%lu,\"throughputBps\":%lu,"
+                 "\"safetyMaxGapUs\":%lu,\"safetyAvgGapUs\":%lu}",
+                 (unsigned long)ota.getReceived(), ota.getElapsedMs(), ota.getThroughputBps(),
+                 gaps.getPeakUs(), gaps.getAverageUs());
+        server.send(200, "application/json", json);
+        Serial.printf("OTA: %lu bytes in %lu ms (%lu B/s), safety gap max %lu us, avg %lu us\n",
+                      (unsigned long)ota.getReceived(), ota.getElapsedMs(), ota.getThroughputBps(),
+                      gaps.getPeakUs(), gaps.getAverageUs());
+        restartPending = true;
+        restartRequestedAt = millis();
+        return;
+    }
 
-String WebInterface::getStatusJson() {
-    DynamicJsonDocument doc(512);
+    if (state != OTA_FAILED) {
+        // No file part in the request, or the upload never finished
+        if (ota.isActive()) {
+            Update.end();
+            ota.fail("incomplete", millis());
+        }
+        sendApiError(400, "no_file", nullptr);
+        return;
+    }
 
-    doc["position"] = awning.getCurrentPosition();
-    doc["target"] = awning.getTargetPosition();
-    doc["travelTime"] = positionTracker.getTravelTime();
-    doc["windPulses"] = windSensor.getPulsesPerMinute();
-    doc["windThreshold"] = windSensor.getThreshold();
-    doc["calibrating"] = calibrationInProgress;
+    const char* error = ota.getError();
+    Serial.printf("OTA: Failed - %s\n", error);
+    if (strcmp(error, "wind_retracting") == 0) {
+        server.sendHeader("Retry-After", String(OTA_RETRY_AFTER_S));
+        sendApiError(503, error, nullptr);
+    } else if (strcmp(error, "too_large") == 0) {
+        sendApiError(413, error, nullptr);
+    } else if (strcmp(error, "invalid_md5") == 0 || strcmp(error, "md5_mismatch") == 0) {
+        sendApiError(400, error, "md5");
+    } else {
+        sendApiError(500, error, nullptr);
+    }
+}
+
+// Progress of the current or last upload
+void WebInterface::handleUpdateStatus() {
+    const LoopStats& gaps = ota.getSafetyGaps();
+    StaticJsonDocument<JSON_OBJECT_SIZE(10)> doc;
+    doc["state"] = OtaSession::stateName(ota.getState());
+    doc["received"] = ota.getReceived();
+    doc["size"] = ota.getExpectedSize();
+    doc["percent"] = ota.getPercent();
+    doc["elapsedMs"] = ota.getElapsedMs();
+    doc["throughputBps"] = ota.getThroughputBps();
+    doc["safetyMaxGapUs"] = gaps.getPeakUs();
+    doc["safetyAvgGapUs"] = gaps.getAverageUs();
+    doc["restartPending"] = restartPending;
+    if (ota.getError()) {
+        doc["error"] = ota.getError();
+    }
+
+    char json[256];
+    serializeJson(doc, json, sizeof(json));
+    server.send(200, "application/json", json);
+}
 
-    // Motor state as string
-    switch (awning.getState()) {
-        case AWNING_EXTENDING: doc["motor"] = "Extending"; break;
-        case AWNING_RETRACTING: doc["motor"] = "Retracting"; break;
-        default: doc["motor"] = "Idle"; break;
+// Reboots into a new image once the response is out and the motor has
+// stopped, so the last position is saved and no relay pulse is cut short
+void WebInterface::restartWhenIdle() {
+    if (!restartPending || millis() - restartRequestedAt < OTA_RESTART_DELAY_MS || awning.isMoving()) {
+        return;
     }
+    Serial.println("OTA: Restarting into new firmware");
+    configManager->setCurrentPosition(awning.getCurrentPosition());
+    configManager->setTargetPosition(awning.getTargetPosition());
+    configManager->save();
+    ESP.restart();
+}
 
-    String result;
-    serializeJson(doc, result);
-    return result;
-}
\ No newline at end of file
+// Loop timing and queue depths, to check that web traffic leaves the
+// control loop alone. ?reset=1 starts a new timing window.
+void WebInterface::handleDiagnostics() {
+    int eventClientCount = 0;
+    for (int i = 0; i < WEB_EVENTS_MAX_CLIENTS; i++) {
+        if (eventClients[i].connected()) {
+            eventClientCount++;
+        }
+    }
+    
+    StaticJsonDocument<JSON_OBJECT_SIZE(21) + JSON_OBJECT_SIZE(BOOT_STAGE_COUNT)> doc;
+    doc["loopAvgUs"] = loopStats.getAverageUs();
+    doc["loopMaxUs"] = loopStats.getMaxUs();
+    doc["loopPeakUs"] = loopStats.getPeakUs();
+    doc["loopCount"] = loopStats.getWindowCount();
+    doc["commandsQueued"] = controlCommands.size();
+    doc["commandsRejected"] = controlCommands.getRejectedCount();
+    doc["transfers"] = activeTransfers();
+    doc["eventClients"] = eventClientCount;
+    doc["httpRequests"] = connectionStats.getRequests();
+    doc["httpConnections"] = connectionStats.getConnections();
+    doc["httpReusePercent"] = connectionStats.getReusePercent();
+    // TIME_WAIT sockets use PCBs too; the low-memory lwIP build has few
+    doc["tcpActive"] = countTcpPcbs(tcp_active_pcbs);
+    doc["tcpTimeWait"] = countTcpPcbs(tcp_tw_pcbs);
+    doc["tcpPcbLimit"] = MEMP_NUM_TCP_PCB;
+    doc["udpPackets"] = udpControl.getPacketCount();
+    doc["udpDropped"] = udpControl.getDroppedCount();
+    doc["freeHeap"] = ESP.getFreeHeap();
+    doc["uptimeMs"] = millis();
+    
+    // Time-to-safe and time-to-online; online waits for MQTT only when it is enabled
+    BootStage onlineStage = configManager->isMQTTEnabled() ? BOOT_MQTT : BOOT_NETWORK;
+    doc["bootSafeMs"] = bootTimeline.getMs(BOOT_POSITION);
+    if (bootTimeline.isReached(onlineStage)) {
+        doc["bootOnlineMs"] = bootTimeline.getMs(onlineStage);
+    }
+    JsonObject boot = doc.createNestedObject("bootStagesMs");
+    for (int i = 0; i < BOOT_STAGE_COUNT; i++) {
+        if (bootTimeline.isReached(i)) {
+            boot[BOOT_STAGE_NAMES[i]] = bootTimeline.getMs(i);
+        }
+    }
+    
+    char json[640];
+    serializeJson(doc, json, sizeof(json));
+    
+    if (server.hasArg("reset")) {
+        loopStats.resetWindow();
+    }
+    server.send(200, "application/json", json);
+}
+
+// Prometheus text exposition, streamed in chunks from a stack buffer
+void WebInterface::handleMetrics() {
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "text/plain; version=0.0.4", "");
+    
+    MetricsWriter<WEB_METRICS_CHUNK_SIZE> w;
+    auto sink = [this](const char* data, size_t length) {
+        server.sendContent(data, length);
+    };
+    
+    w.metric("awning_uptime_seconds", "counter", "Time since boot", millis() / 1000.0, sink);
+    w.metric("awning_heap_free_bytes", "gauge", "Free heap", ESP.getFreeHeap(), sink);
+    w.metric("awning_heap_max_block_bytes", "gauge", "Largest allocatable heap block", ESP.getMaxFreeBlockSize(), sink);
+    w.metric("awning_heap_fragmentation_percent", "gauge", "Heap fragmentation", ESP.getHeapFragmentation(), sink);
+    w.metric("awning_wifi_rssi_dbm", "gauge", "WiFi signal strength", WiFi.RSSI(), sink);
+    
+    w.metric("awning_loop_iterations_total", "counter", "Main loop iterations", loopStats.getTotalCount(), sink);
+    w.metric("awning_loop_seconds_total", "counter", "Time spent in the main loop",
+             loopStats.getTotalUs() / 1e6, sink);
+    w.metric("awning_loop_peak_seconds", "gauge", "Longest main loop iteration since boot",
+             loopStats.getPeakUs() / 1e6, sink);
+    
+    char labels[24];
+    w.family("awning_task_seconds_total", "counter", "Time spent per main loop task", sink);
+    for (int i = 0; i < LOOP_TASK_COUNT; i++) {
+        snprintf(labels, sizeof(labels), "task=\"%s\"", LOOP_TASK_NAMES[i]);
+        w.sample("awning_task_seconds_total", labels, taskStats[i].getTotalUs() / 1e6, sink);
+    }
+    w.family("awning_task_peak_seconds", "gauge", "Longest run of each main loop task since boot", sink);
+    for (int i = 0; i < LOOP_TASK_COUNT; i++) {
+        snprintf(labels, sizeof(labels), "task=\"%s\"", LOOP_TASK_NAMES[i]);
+        w.sample("awning_task_peak_seconds", labels, taskStats[i].getPeakUs() / 1e6, sink);
+    }
+    
+    w.family("awning_boot_stage_seconds", "gauge", "Time from reset until each startup stage was reached", sink);
+    for (int i = 0; i < BOOT_STAGE_COUNT; i++) {
+        if (bootTimeline.isReached(i)) {
+            snprintf(labels, sizeof(labels), "stage=\"%s\"", BOOT_STAGE_NAMES[i]);
+            w.sample("awning_boot_stage_seconds", labels, bootTimeline.getUs(i) / 1e6, sink);
+        }
+    }
+    
+    w.metric("awning_mqtt_connected", "gauge", "MQTT connection up", configManager->isMQTTEnabled() && mqtt.isConnected() ? 1 : 0, sink);
+    w.metric("awning_mqtt_connect_failures_total", "counter", "Failed MQTT connection attempts", mqtt.getConnectFailures(), sink);
+    w.metric("awning_mqtt_publishes_total", "counter", "MQTT messages published", mqtt.getPublishCount(), sink);
+    w.metric("awning_mqtt_publish_failures_total", "counter", "MQTT publishes that failed", mqtt.getPublishFailures(), sink);
+    w.metric("awning_mqtt_queued_messages", "gauge", "Messages waiting in the outbound queue", mqtt.getQueuedCount(), sink);
+    w.metric("awning_mqtt_dropped_total", "counter", "Outbound messages dropped from a full queue", mqtt.getDroppedCount(), sink);
+    
+    w.metric("awning_relay_pulses_total", "counter", "Relay pulses sent to the motor", motor.getActivationCount(), sink);
+    w.metric("awning_position_percent", "gauge", "Estimated awning position", awning.getCurrentPosition(), sink);
+    w.metric("awning_target_percent", "gauge", "Target position", awning.getTargetPosition(), sink);
+    w.metric("awning_travel_since_end_stop_percent", "gauge",
+             "Travel since the last end position; position drift grows with it", travelSinceEndStop, sink);
+    
+    w.metric("awning_wind_pulses_per_minute", "gauge", "Current wind sensor rate", windSensor.getPulsesPerMinute(), sink);
+    w.metric("awning_wind_threshold_pulses_per_minute", "gauge", "Wind retract threshold", windSensor.getThreshold(), sink);
+    w.metric("awning_wind_pulses_total", "counter", "Wind sensor pulses since boot", (unsigned long)windPulseCount, sink);
+    
+    w.metric("awning_http_requests_total", "counter", "HTTP requests handled", connectionStats.getRequests(), sink);
+    w.metric("awning_http_connections_total", "counter", "HTTP connections opened", connectionStats.getConnections(), sink);
+    
+    w.flush(sink);
+    server.sendContent("");
+}
+
+void WebInterface::handleNotFound() {
+    server.send(404, "text/plain", "Not Found");
+}
+
+
+StatusSnapshot WebInterface::getStatusSnapshot() {
+    StatusSnapshot status;
+    status.position = awning.getCurrentPosition();
+    status.target = awning.getTargetPosition();
+    status.motor = awning.getState();
+    status.windPulses = windSensor.getPulsesPerMinute();
+    status.windThreshold = windSensor.getThreshold();
+    status.travelTime = positionTracker.getTravelTime();
+    status.calibrating = calibration.isActive();
+    return status;
+}
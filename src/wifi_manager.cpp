@@ -1,11 +1,18 @@
 #include "wifi_manager.h"
+#include "html_stream.h"
+#include "web_templates.h"
+#include "constants.h"
 
 const char* WiFiManager::AP_SSID = "Sonnensegel";
 const char* WiFiManager::AP_PASSWORD = nullptr;
 
+static_assert(sizeof(RtcRecord<WiFiRtcState>) % 4 == 0, "RTC memory is accessed in 4-byte blocks");
+
 WiFiManager::WiFiManager(ConfigManager* config) 
     : configManager(config), configServer(nullptr), dnsServer(nullptr), currentMode(AWNING_WIFI_CONNECTING),
-      lastConnectionAttempt(0), lastStatusCheck(0), connectionAttempts(0), apStarted(false), hasRetriedFromAP(false) {
+      lastConnectionAttempt(0), lastStatusCheck(0), connectionAttempts(0), apStarted(false), hasRetriedFromAP(false),
+      fastConnectAttempt(false), connectStartedAt(0), lastConnectDuration(0), lastConnectWasFast(false),
+      scanRunning(false), scanStartedAt(0) {
 }
 
 WiFiManager::~WiFiManager() {
@@ -54,7 +61,12 @@ bool WiFiManager::connectToWiFi() {
         Serial.printf("WiFi: Hostname set to '%s'\n", hostname);
     }
     
-    WiFi.begin(ssid, password);
+    connectStartedAt = millis();
+    fastConnectAttempt = beginFastConnect(ssid, password);
+    if (!fastConnectAttempt) {
+        WiFi.config(0U, 0U, 0U);  // DHCP
+        WiFi.begin(ssid, password);
+    }
     
     currentMode = AWNING_WIFI_CONNECTING;
     lastConnectionAttempt = millis();
@@ -63,6 +75,79 @@ bool WiFiManager::connectToWiFi() {
     return true;
 }
 
+uint32_t WiFiManager::credentialsHash() const {
+    const char* ssid = configManager->getWiFiSSID();
+    const char* password = configManager->getWiFiPassword();
+    return rtcCrc32(password, strlen(password), rtcCrc32(ssid, strlen(ssid) + 1));
+}
+
+// Joins the access point of the last connection directly on its channel,
+// which skips the scan. After a reset the address from RTC memory is reused
+// as well, skipping DHCP; after a power cycle only the access point from
+// the config is known. Returns false when nothing usable was learned.
+bool WiFiManager::beginFastConnect(const char* ssid, const char* password) {
+    uint32_t hash = credentialsHash();
+    
+    RtcRecord<WiFiRtcState> record;
+    if (ESP.rtcUserMemoryRead(RTC_WIFI_BLOCK, (uint32_t*)&record, sizeof(record)) &&
+        record.isValid(RTC_WIFI_MAGIC) && record.payload.accessPoint.credentialsHash == hash &&
+        record.payload.accessPoint.channel > 0 && record.payload.ip != 0) {
+        const WiFiRtcState& state = record.payload;
+        WiFi.config(IPAddress(state.ip), IPAddress(state.gateway), IPAddress(state.subnet), IPAddress(state.dns));
+        WiFi.begin(ssid, password, state.accessPoint.channel, state.accessPoint.bssid);
+        Serial.printf("WiFi: Fast connect on channel %u with %s\n", state.accessPoint.channel,
+                      IPAddress(state.ip).toString().c_str());
+        return true;
+    }
+    
+    const WiFiFastConnectConfig& accessPoint = configManager->getWiFiFastConnect();
+    if (accessPoint.credentialsHash == hash && accessPoint.channel > 0) {
+        WiFi.config(0U, 0U, 0U);
+        WiFi.begin(ssid, password, accessPoint.channel, accessPoint.bssid);
+        Serial.printf("WiFi: Fast connect on channel %u\n", accessPoint.channel);
+        return true;
+    }
+    return false;
+}
+
+// The access point moved, changed channel or refused the cached address
+void WiFiManager::fallBackToFullConnect() {
+    Serial.println("WiFi: Fast connect failed, scanning for the network");
+    fastConnectAttempt = false;
+    
+    RtcRecord<WiFiRtcState> record;
+    record.invalidate();
+    ESP.rtcUserMemoryWrite(RTC_WIFI_BLOCK, (uint32_t*)&record, sizeof(record));
+    
+    WiFi.disconnect();
+    WiFi.config(0U, 0U, 0U);
+    WiFi.begin(configManager->getWiFiSSID(), configManager->getWiFiPassword());
+    lastConnectionAttempt = millis();
+}
+
+// Stores where this connection went for the next fast connect. The config
+// is only written when the access point changed, to spare the flash.
+void WiFiManager::rememberConnection() {
+    RtcRecord<WiFiRtcState> record;
+    WiFiRtcState& state = record.payload;
+    memset(&state, 0, sizeof(state));
+    memcpy(state.accessPoint.bssid, WiFi.BSSID(), sizeof(state.accessPoint.bssid));
+    state.accessPoint.channel = WiFi.channel();
+    state.accessPoint.credentialsHash = credentialsHash();
+    state.ip = WiFi.localIP();
+    state.gateway = WiFi.gatewayIP();
+    state.subnet = WiFi.subnetMask();
+    state.dns = WiFi.dnsIP();
+    record.seal(RTC_WIFI_MAGIC);
+    ESP.rtcUserMemoryWrite(RTC_WIFI_BLOCK, (uint32_t*)&record, sizeof(record));
+    
+    const WiFiFastConnectConfig& stored = configManager->getWiFiFastConnect();
+    if (memcmp(&stored, &state.accessPoint, sizeof(stored)) != 0) {
+        configManager->setWiFiFastConnect(state.accessPoint);
+        configManager->save();
+    }
+}
+
 void WiFiManager::startAP() {
     if (apStarted) {
         return;
@@ -93,6 +178,9 @@ void WiFiManager::startAP() {
         
         currentMode = AWNING_WIFI_AP_FALLBACK;
         apStarted = true;
+        
+        // The portal page asks for networks first thing; have them ready
+        startScan();
     } else {
         Serial.println("WiFi: Failed to start AP");
         currentMode = AWNING_WIFI_FAILED;
@@ -152,22 +240,33 @@ void WiFiManager::update() {
         if (configServer) {
             configServer->handleClient();
         }
+        updateScan();
     }
     
-    // Check connection status periodically
-    if (now - lastStatusCheck >= STATUS_CHECK_INTERVAL) {
+    // Check connection status periodically, and on every call while
+    // connecting so services start as soon as the link is up
+    if (currentMode == AWNING_WIFI_CONNECTING || now - lastStatusCheck >= STATUS_CHECK_INTERVAL) {
         lastStatusCheck = now;
         
         if (currentMode == AWNING_WIFI_CONNECTING) {
-            if (WiFi.status() == WL_CONNECTED) {
-                Serial.printf("WiFi: Connected! IP: %s\n", WiFi.localIP().toString().c_str());
+            wl_status_t status = WiFi.status();
+            if (status == WL_CONNECTED) {
+                lastConnectDuration = now - connectStartedAt;
+                lastConnectWasFast = fastConnectAttempt;
+                Serial.printf("WiFi: Connected! IP: %s (%s connect, %lu ms)\n", WiFi.localIP().toString().c_str(),
+                              fastConnectAttempt ? "fast" : "full", lastConnectDuration);
                 currentMode = AWNING_WIFI_CONNECTED;
                 connectionAttempts = 0;
+                fastConnectAttempt = false;
+                rememberConnection();
                 
                 // Stop AP if it was running
                 if (apStarted) {
                     stopAP();
                 }
+            } else if (fastConnectAttempt && (status == WL_NO_SSID_AVAIL || status == WL_CONNECT_FAILED ||
+                                              now - lastConnectionAttempt >= FAST_CONNECT_TIMEOUT)) {
+                fallBackToFullConnect();
             } else if (now - lastConnectionAttempt >= CONNECTION_TIMEOUT) {
                 Serial.println("WiFi: Connection timeout");
                 
@@ -218,207 +317,9 @@ String WiFiManager::getAPIP() const {
 }
 
 void WiFiManager::handleConfigRoot() {
-    String html = R"rawliteral(
-<!DOCTYPE html>
-<html>
-<head>
-    <title>Awning Controller Setup</title>
-    <meta name="viewport" content="width=device-width, initial-scale=1">
-    <style>
-        body { font-family: Arial, sans-serif; margin: 20px; background: #f0f0f0; }
-        .container { max-width: 500px; margin: 0 auto; background: white; padding: 20px; border-radius: 10px; }
-        h1 { color: #333; text-align: center; }
-        .form-group { margin: 15px 0; }
-        label { display: block; margin-bottom: 5px; font-weight: bold; }
-        input[type="text"], input[type="password"], input[type="number"] { 
-            width: 100%; padding: 8px; border: 1px solid #ddd; border-radius: 4px; box-sizing: border-box; 
-        }
-        button { 
-            background: #4CAF50; color: white; padding: 10px 20px; 
-            border: none; border-radius: 4px; cursor: pointer; width: 100%; font-size: 16px; 
-        }
-        button:hover { background: #45a049; }
-        .section { margin: 20px 0; padding: 15px; border: 1px solid #ddd; border-radius: 5px; }
-        .info { background: #e3f2fd; padding: 10px; border-radius: 4px; margin: 10px 0; }
-        .btn-scan { background: #2196F3; margin-bottom: 10px; }
-        .btn-scan:hover { background: #1976D2; }
-        .wifi-networks { max-height: 200px; overflow-y: auto; border: 1px solid #ddd; border-radius: 4px; margin: 10px 0; }
-        .wifi-network { 
-            padding: 10px; border-bottom: 1px solid #eee; cursor: pointer; display: flex; justify-content: space-between; align-items: center;
-        }
-        .wifi-network:hover { background: #f5f5f5; }
-        .wifi-network:last-child { border-bottom: none; }
-        .wifi-ssid { font-weight: bold; }
-        .wifi-signal { 
-            font-size: 12px; color: #666; display: flex; align-items: center; gap: 5px;
-        }
-        .signal-bars { font-size: 16px; }
-        .wifi-lock { color: #ff9800; }
-        .scanning { text-align: center; padding: 20px; color: #666; }
-    </style>
-</head>
-<body>
-    <div class="container">
-        <h1>Awning Controller Setup</h1>
-        
-        <div class="info">
-            Connect to your WiFi network and configure MQTT settings.
-        </div>
-        
-        <form method="POST" action="/save">
-            <div class="section">
-                <h3>WiFi Configuration</h3>
-                
-                <button type="button" class="btn-scan" onclick="scanWiFi()">Scan for Networks</button>
-                <div id="wifi-networks" class="wifi-networks" style="display: none;"></div>
-                
-                <div class="form-group">
-                    <label>WiFi Network (SSID):</label>
-                    <input type="text" id="wifi_ssid" name="wifi_ssid" value=")rawliteral" + 
-                    String(configManager->getWiFiSSID()) + R"rawliteral(" required>
-                </div>
-                <div class="form-group">
-                    <label>WiFi Password:</label>
-                    <input type="password" name="wifi_password" value="">
-                </div>
-            </div>
-            
-            <div class="section">
-                <h3>MQTT Configuration</h3>
-                <div class="form-group">
-                    <label>
-                        <input type="checkbox" name="mqtt_enabled" value="1" )rawliteral" + 
-                        String(configManager->isMQTTEnabled() ? "checked" : "") + R"rawliteral(> 
-                        Enable MQTT Integration
-                    </label>
-                </div>
-                <div class="form-group">
-                    <label>MQTT Server:</label>
-                    <input type="text" name="mqtt_server" value=")rawliteral" + 
-                    String(configManager->getMQTTServer()) + R"rawliteral(">
-                </div>
-                <div class="form-group">
-                    <label>MQTT Port:</label>
-                    <input type="number" name="mqtt_port" value=")rawliteral" + 
-                    String(configManager->getMQTTPort()) + R"rawliteral(" min="1" max="65535">
-                </div>
-                <div class="form-group">
-                    <label>MQTT Username (optional):</label>
-                    <input type="text" name="mqtt_username" value=")rawliteral" + 
-                    String(configManager->getMQTTUsername()) + R"rawliteral(">
-                </div>
-                <div class="form-group">
-                    <label>MQTT Password (optional):</label>
-                    <input type="password" name="mqtt_password" value="">
-                </div>
-                <div class="form-group">
-                    <label>Client ID:</label>
-                    <input type="text" name="mqtt_client_id" value=")rawliteral" + 
-                    String(configManager->getMQTTClientId()) + R"rawliteral(">
-                </div>
-                <div class="form-group">
-                    <label>Base Topic:</label>
-                    <input type="text" name="mqtt_base_topic" value=")rawliteral" + 
-                    String(configManager->getMQTTBaseTopic()) + R"rawliteral(">
-                </div>
-            </div>
-            
-            <button type="submit">Save Configuration</button>
-        </form>
-        
-        <div style="text-align: center; margin-top: 20px;">
-            <a href="/status">Check Status</a>
-            <br><br>
-            <button type="button" onclick="factoryReset()" style="background: #f44336; width: auto; padding: 8px 16px; font-size: 14px;">
-                Factory Reset
-            </button>
-        </div>
-    </div>
-    
-    <script>
-        function scanWiFi() {
-            const button = document.querySelector('.btn-scan');
-            const networksDiv = document.getElementById('wifi-networks');
-            
-            button.textContent = 'Scanning...';
-            button.disabled = true;
-            
-            networksDiv.innerHTML = '<div class="scanning">Scanning for WiFi networks...</div>';
-            networksDiv.style.display = 'block';
-            
-            fetch('/scan')
-                .then(response => response.json())
-                .then(networks => {
-                    displayNetworks(networks);
-                    button.textContent = 'Scan for Networks';
-                    button.disabled = false;
-                })
-                .catch(error => {
-                    console.error('Scan failed:', error);
-                    networksDiv.innerHTML = '<div class="scanning">Scan failed. Please try again.</div>';
-                    button.textContent = 'Scan for Networks';
-                    button.disabled = false;
-                });
-        }
-        
-        function displayNetworks(networks) {
-            const networksDiv = document.getElementById('wifi-networks');
-            
-            if (networks.length === 0) {
-                networksDiv.innerHTML = '<div class="scanning">No networks found</div>';
-                return;
-            }
-            
-            // Sort by signal strength (RSSI)
-            networks.sort((a, b) => b.rssi - a.rssi);
-            
-            let html = '';
-            networks.forEach(network => {
-                if (network.ssid && network.ssid.trim() !== '') {
-                    html += `
-                        <div class="wifi-network" onclick="selectNetwork('${escapeHtml(network.ssid)}')">
-                            <div class="wifi-ssid">${escapeHtml(network.ssid)}</div>
-                            <div class="wifi-signal">
-                                <span>${network.rssi} dBm</span>
-                            </div>
-                        </div>
-                    `;
-                }
-            });
-            
-            networksDiv.innerHTML = html || '<div class="scanning">No networks found</div>';
-        }
-        
-        function selectNetwork(ssid) {
-            document.getElementById('wifi_ssid').value = ssid;
-            document.getElementById('wifi-networks').style.display = 'none';
-        }
-        
-        
-        function escapeHtml(text) {
-            const div = document.createElement('div');
-            div.textContent = text;
-            return div.innerHTML;
-        }
-        
-        function factoryReset() {
-            if (confirm('Are you sure you want to reset all settings to defaults? This will erase WiFi, MQTT, and awning configuration. The device will restart.')) {
-                fetch('/reset', { method: 'POST' })
-                    .then(() => {
-                        alert('Factory reset initiated. Device will restart...');
-                    })
-                    .catch(error => {
-                        console.error('Reset failed:', error);
-                        alert('Reset failed. Please try again.');
-                    });
-            }
-        }
-    </script>
-</body>
-</html>
-)rawliteral";
-    
-    configServer->send(200, "text/html", html);
+    streamHtmlTemplate(*configServer, WIFI_SETUP_TEMPLATE, [this](const char* name, char* scratch, size_t scratchSize) {
+        return resolveConfigPlaceholder(*configManager, name, scratch, scratchSize);
+    });
 }
 
 void WiFiManager::handleConfigSave() {
@@ -547,35 +448,75 @@ void WiFiManager::handleConfigStatus() {
     configServer->send(200, "text/html", html);
 }
 
-void WiFiManager::handleWiFiScan() {
+// Starts a scan in the background; update() collects the result
+void WiFiManager::startScan() {
+    if (scanRunning) {
+        return;
+    }
+    if (WiFi.scanNetworks(true, false) != WIFI_SCAN_RUNNING) {
+        Serial.println("WiFi: Failed to start network scan");
+        return;
+    }
     Serial.println("WiFi: Starting network scan...");
+    scanRunning = true;
+    scanStartedAt = millis();
+}
+
+void WiFiManager::updateScan() {
+    if (!scanRunning) {
+        return;
+    }
     
-    // Start WiFi scan
-    int networkCount = WiFi.scanNetworks();
-    
-    // Build JSON response
-    String json = "[";
-    
-    if (networkCount > 0) {
-        for (int i = 0; i < networkCount; i++) {
-            if (i > 0) json += ",";
-            
-            json += "{";
-            json += "\"ssid\":\"" + WiFi.SSID(i) + "\",";
-            json += "\"rssi\":" + String(WiFi.RSSI(i));
-            json += "}";
+    int networkCount = WiFi.scanComplete();
+    if (networkCount == WIFI_SCAN_RUNNING) {
+        if (millis() - scanStartedAt >= SCAN_TIMEOUT) {
+            Serial.println("WiFi: Network scan timed out");
+            WiFi.scanDelete();
+            scanRunning = false;
         }
+        return;
     }
     
-    json += "]";
+    scanRunning = false;
+    if (networkCount < 0) {
+        Serial.println("WiFi: Network scan failed");
+        return;
+    }
     
-    Serial.printf("WiFi: Scan complete - found %d networks\n", networkCount);
+    scanCache.clear();
+    for (int i = 0; i < networkCount; i++) {
+        scanCache.add(WiFi.SSID(i).c_str(), WiFi.RSSI(i));
+    }
+    scanCache.complete(millis());
     
+    // The SDK's copy of the results is no longer needed
+    WiFi.scanDelete();
+    Serial.printf("WiFi: Scan complete - found %d networks\n", networkCount);
+}
+
+// Answers from the cache while it is fresh. Otherwise a scan is started and
+// 202 tells the page to ask again shortly, so no request waits on the radio.
+void WiFiManager::handleWiFiScan() {
     configServer->sendHeader("Access-Control-Allow-Origin", "*");
-    configServer->send(200, "application/json", json);
     
-    // Clean up scan results
-    WiFi.scanDelete();
+    if (!scanCache.isFresh(millis(), SCAN_CACHE_TTL)) {
+        startScan();
+        configServer->send(202, "application/json", "[]");
+        return;
+    }
+    
+    configServer->setContentLength(CONTENT_LENGTH_UNKNOWN);
+    configServer->send(200, "application/json", "");
+    
+    HtmlTemplateWriter<HTML_STREAM_CHUNK_SIZE> writer;
+    auto sink = [this](const char* data, size_t length) {
+        configServer->sendContent(data, length);
+    };
+    scanCache.writeJson(writer, sink);
+    writer.flush(sink);
+    
+    // Zero-length chunk ends the response
+    configServer->sendContent("");
 }
 
 void WiFiManager::handleFactoryReset() {
@@ -353,6 +353,54 @@ void test_new_target_after_reaching_target_works() {
     TEST_ASSERT_EQUAL(AWNING_EXTENDING, awning->getState());
 }
 
+// =============================================================================
+// Resume After Reset
+// =============================================================================
+
+// Counts pulses so a resumed movement can be checked for sending none
+class CountingHardware : public IMotorHardware {
+public:
+    int startPulses = 0;
+    int stopPulses = 0;
+    void sendStartPulse(uint8_t) override { startPulses++; }
+    void sendStopPulse(uint8_t) override { stopPulses++; }
+    void deactivateRelays() override {}
+};
+
+void test_resume_motion_sends_no_pulse() {
+    CountingHardware hardware;
+    AwningStateMachine machine(*tracker, &hardware);
+    machine.setCurrentPosition(40.0f);
+    machine.resumeMotion(AWNING_EXTENDING, 60.0f);
+
+    TEST_ASSERT_EQUAL(AWNING_EXTENDING, machine.getState());
+    TEST_ASSERT_EQUAL(PIN_RELAY_EXTEND, machine.getLastMovementRelay());
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 60.0f, machine.getTargetPosition());
+    TEST_ASSERT_EQUAL(0, hardware.startPulses);
+    TEST_ASSERT_EQUAL(0, hardware.stopPulses);
+}
+
+void test_resumed_motion_stops_at_target() {
+    tracker->setTravelTime(10000);
+    awning->setCurrentPosition(50.0f);
+    awning->resumeMotion(AWNING_RETRACTING, 45.0f);
+
+    for (int i = 0; i < 20; i++) {
+        mockTime += 100;
+        awning->update(mockTime);
+    }
+
+    TEST_ASSERT_EQUAL(AWNING_IDLE, awning->getState());
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 45.0f, awning->getCurrentPosition());
+}
+
+void test_resume_with_idle_is_ignored() {
+    awning->setCurrentPosition(30.0f);
+    awning->resumeMotion(AWNING_IDLE, 80.0f);
+
+    TEST_ASSERT_EQUAL(AWNING_IDLE, awning->getState());
+}
+
 // =============================================================================
 // Test Runner
 // =============================================================================
@@ -406,5 +454,10 @@ int main(int argc, char **argv) {
     RUN_TEST(test_new_target_after_stop_works);
     RUN_TEST(test_new_target_after_reaching_target_works);
 
+    // Resume after reset
+    RUN_TEST(test_resume_motion_sends_no_pulse);
+    RUN_TEST(test_resumed_motion_stops_at_target);
+    RUN_TEST(test_resume_with_idle_is_ignored);
+
     return UNITY_END();
 }
@@ -0,0 +1,87 @@
+#include <unity.h>
+#include "boot_timeline.h"
+
+static BootTimeline<4>* timeline;
+
+void setUp() {
+    timeline = new BootTimeline<4>();
+}
+
+void tearDown() {
+    delete timeline;
+}
+
+// =============================================================================
+// Marking Tests
+// =============================================================================
+
+void test_stages_start_unreached() {
+    TEST_ASSERT_FALSE(timeline->isReached(0));
+    TEST_ASSERT_EQUAL(0, timeline->getUs(0));
+}
+
+void test_mark_records_time() {
+    TEST_ASSERT_TRUE(timeline->mark(1, 52000));
+
+    TEST_ASSERT_TRUE(timeline->isReached(1));
+    TEST_ASSERT_EQUAL(52000, timeline->getUs(1));
+    TEST_ASSERT_EQUAL(52, timeline->getMs(1));
+}
+
+void test_only_first_mark_counts() {
+    timeline->mark(2, 1000);
+
+    TEST_ASSERT_FALSE(timeline->mark(2, 9000));
+    TEST_ASSERT_EQUAL(1000, timeline->getUs(2));
+}
+
+void test_unknown_stage_is_ignored() {
+    TEST_ASSERT_FALSE(timeline->mark(4, 1000));
+    TEST_ASSERT_FALSE(timeline->isReached(4));
+}
+
+// =============================================================================
+// Duration Tests
+// =============================================================================
+
+void test_first_stage_duration_is_from_reset() {
+    timeline->mark(0, 3000);
+
+    TEST_ASSERT_EQUAL(3000, timeline->getDurationUs(0));
+}
+
+void test_duration_is_from_previous_stage() {
+    timeline->mark(0, 3000);
+    timeline->mark(1, 10000);
+
+    TEST_ASSERT_EQUAL(7000, timeline->getDurationUs(1));
+}
+
+void test_duration_skips_unreached_stages() {
+    timeline->mark(0, 3000);
+    timeline->mark(3, 20000);
+
+    TEST_ASSERT_EQUAL(17000, timeline->getDurationUs(3));
+    TEST_ASSERT_EQUAL(0, timeline->getDurationUs(2));
+}
+
+// =============================================================================
+// Test Runner
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Marking
+    RUN_TEST(test_stages_start_unreached);
+    RUN_TEST(test_mark_records_time);
+    RUN_TEST(test_only_first_mark_counts);
+    RUN_TEST(test_unknown_stage_is_ignored);
+
+    // Durations
+    RUN_TEST(test_first_stage_duration_is_from_reset);
+    RUN_TEST(test_duration_is_from_previous_stage);
+    RUN_TEST(test_duration_skips_unreached_stages);
+
+    return UNITY_END();
+}
@@ -0,0 +1,120 @@
+#include <unity.h>
+#include "broker_failover.h"
+
+static BrokerFailover* failover;
+
+void setUp() {
+    failover = new BrokerFailover();
+}
+
+void tearDown() {
+    delete failover;
+}
+
+// =============================================================================
+// Single Broker Tests
+// =============================================================================
+
+void test_starts_on_primary() {
+    TEST_ASSERT_TRUE(failover->isOnPrimary());
+    TEST_ASSERT_EQUAL(0, failover->getActiveIndex());
+}
+
+void test_single_broker_failure_backs_off() {
+    failover->setBrokerCount(1);
+
+    TEST_ASSERT_FALSE(failover->onConnectFailed());
+    TEST_ASSERT_TRUE(failover->isOnPrimary());
+}
+
+void test_broker_count_is_clamped() {
+    failover->setBrokerCount(0);
+    TEST_ASSERT_EQUAL(1, failover->getBrokerCount());
+
+    failover->setBrokerCount(10);
+    TEST_ASSERT_EQUAL(BrokerFailover::MAX_BROKERS, failover->getBrokerCount());
+}
+
+// =============================================================================
+// Failover Tests
+// =============================================================================
+
+void test_first_failure_switches_to_secondary_immediately() {
+    failover->setBrokerCount(2);
+
+    TEST_ASSERT_TRUE(failover->onConnectFailed());
+    TEST_ASSERT_EQUAL(1, failover->getActiveIndex());
+}
+
+void test_all_brokers_failed_backs_off_and_restarts_at_primary() {
+    failover->setBrokerCount(2);
+    failover->onConnectFailed();
+
+    TEST_ASSERT_FALSE(failover->onConnectFailed());
+    TEST_ASSERT_TRUE(failover->isOnPrimary());
+}
+
+void test_connect_resets_round() {
+    failover->setBrokerCount(2);
+    failover->onConnectFailed();
+    failover->onConnected(1000);
+
+    // Secondary drops: next failure moves on immediately again
+    TEST_ASSERT_TRUE(failover->onConnectFailed());
+    TEST_ASSERT_TRUE(failover->isOnPrimary());
+}
+
+// =============================================================================
+// Primary Probe Tests
+// =============================================================================
+
+void test_no_probe_while_on_primary() {
+    failover->setBrokerCount(2);
+    failover->onConnected(0);
+
+    TEST_ASSERT_FALSE(failover->shouldProbePrimary(1000000, 60000));
+}
+
+void test_probe_after_interval_on_secondary() {
+    failover->setBrokerCount(2);
+    failover->onConnectFailed();
+    failover->onConnected(1000);
+
+    TEST_ASSERT_FALSE(failover->shouldProbePrimary(30000, 60000));
+    TEST_ASSERT_TRUE(failover->shouldProbePrimary(61000, 60000));
+    // Interval restarts after each probe
+    TEST_ASSERT_FALSE(failover->shouldProbePrimary(62000, 60000));
+}
+
+void test_switch_to_primary() {
+    failover->setBrokerCount(2);
+    failover->onConnectFailed();
+    failover->switchToPrimary();
+
+    TEST_ASSERT_TRUE(failover->isOnPrimary());
+}
+
+// =============================================================================
+// Test Runner
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Single broker
+    RUN_TEST(test_starts_on_primary);
+    RUN_TEST(test_single_broker_failure_backs_off);
+    RUN_TEST(test_broker_count_is_clamped);
+
+    // Failover
+    RUN_TEST(test_first_failure_switches_to_secondary_immediately);
+    RUN_TEST(test_all_brokers_failed_backs_off_and_restarts_at_primary);
+    RUN_TEST(test_connect_resets_round);
+
+    // Primary probe
+    RUN_TEST(test_no_probe_while_on_primary);
+    RUN_TEST(test_probe_after_interval_on_secondary);
+    RUN_TEST(test_switch_to_primary);
+
+    return UNITY_END();
+}
@@ -0,0 +1,143 @@
+#include <unity.h>
+#include "calibration_session.h"
+
+static CalibrationSession* session;
+
+static const unsigned long MIN_RUN_MS = 5000;
+static const unsigned long PAUSE_MS = 2000;
+
+void setUp() {
+    session = new CalibrationSession();
+}
+
+void tearDown() {
+    delete session;
+}
+
+// Starts the current run at start and stops it duration later
+static void run(unsigned long start, unsigned long duration) {
+    session->onMotorStarted(start);
+    session->onStopEvent(start + duration);
+}
+
+// =============================================================================
+// Statistics Tests
+// =============================================================================
+
+void test_stats_mean_and_variance() {
+    TravelTimeStats stats;
+    stats.add(15000);
+    stats.add(15200);
+    stats.add(14800);
+
+    TEST_ASSERT_EQUAL(3, stats.getCount());
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 15000.0, stats.getMean());
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 40000.0, stats.getVariance());
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 200.0, stats.getStdDev());
+}
+
+void test_stats_single_run_has_no_variance() {
+    TravelTimeStats stats;
+    stats.add(15000);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 0.0, stats.getVariance());
+}
+
+// =============================================================================
+// Run Sequence Tests
+// =============================================================================
+
+void test_begin_requests_extend_run() {
+    session->begin(2, MIN_RUN_MS);
+
+    TEST_ASSERT_TRUE(session->isActive());
+    TEST_ASSERT_TRUE(session->isStartDue(0, PAUSE_MS));
+    TEST_ASSERT_EQUAL(CALIBRATE_EXTEND, session->getDirection());
+}
+
+void test_run_is_timed_from_activation_to_stop_event() {
+    session->begin(1, MIN_RUN_MS);
+    session->onMotorStarted(1000);
+
+    TEST_ASSERT_FALSE(session->isStartDue(1500, PAUSE_MS));
+    TEST_ASSERT_TRUE(session->onStopEvent(16050));
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 15050.0, session->getExtendStats().getMean());
+}
+
+void test_directions_alternate_with_pause() {
+    session->begin(2, MIN_RUN_MS);
+    run(1000, 15000);
+
+    TEST_ASSERT_EQUAL(CALIBRATE_RETRACT, session->getDirection());
+    TEST_ASSERT_FALSE(session->isStartDue(17000, PAUSE_MS));
+    TEST_ASSERT_TRUE(session->isStartDue(18000, PAUSE_MS));
+}
+
+void test_early_stop_event_is_ignored() {
+    session->begin(1, MIN_RUN_MS);
+    session->onMotorStarted(1000);
+
+    TEST_ASSERT_FALSE(session->onStopEvent(2000));
+    TEST_ASSERT_EQUAL(CALIBRATION_RUNNING, session->getPhase());
+}
+
+void test_stop_event_without_run_is_ignored() {
+    session->begin(1, MIN_RUN_MS);
+
+    TEST_ASSERT_FALSE(session->onStopEvent(20000));
+}
+
+void test_completes_after_all_runs() {
+    session->begin(2, MIN_RUN_MS);
+    run(0, 15000);
+    run(20000, 14000);
+    run(40000, 15200);
+    TEST_ASSERT_TRUE(session->isActive());
+    run(60000, 14200);
+
+    TEST_ASSERT_FALSE(session->isActive());
+    TEST_ASSERT_TRUE(session->isCompleted());
+    TEST_ASSERT_EQUAL(4, session->getCompletedRuns());
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 15100.0, session->getExtendStats().getMean());
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 14100.0, session->getRetractStats().getMean());
+    TEST_ASSERT_EQUAL(14600, session->getTravelTime());
+}
+
+void test_cancel_does_not_complete() {
+    session->begin(1, MIN_RUN_MS);
+    run(0, 15000);
+    session->cancel();
+
+    TEST_ASSERT_FALSE(session->isActive());
+    TEST_ASSERT_FALSE(session->isCompleted());
+}
+
+void test_runs_are_clamped() {
+    session->begin(20, MIN_RUN_MS);
+
+    TEST_ASSERT_EQUAL(CalibrationSession::MAX_RUNS_PER_DIRECTION, session->getRunsPerDirection());
+}
+
+// =============================================================================
+// Test Runner
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Statistics
+    RUN_TEST(test_stats_mean_and_variance);
+    RUN_TEST(test_stats_single_run_has_no_variance);
+
+    // Run sequence
+    RUN_TEST(test_begin_requests_extend_run);
+    RUN_TEST(test_run_is_timed_from_activation_to_stop_event);
+    RUN_TEST(test_directions_alternate_with_pause);
+    RUN_TEST(test_early_stop_event_is_ignored);
+    RUN_TEST(test_stop_event_without_run_is_ignored);
+    RUN_TEST(test_completes_after_all_runs);
+    RUN_TEST(test_cancel_does_not_complete);
+    RUN_TEST(test_runs_are_clamped);
+
+    return UNITY_END();
+}
@@ -0,0 +1,75 @@
+#include <unity.h>
+#include "connection_stats.h"
+
+static ConnectionStats* stats;
+
+static const uint32_t CLIENT_A = 0x0A00000A;
+static const uint32_t CLIENT_B = 0x0B00000A;
+
+void setUp() {
+    stats = new ConnectionStats();
+}
+
+void tearDown() {
+    delete stats;
+}
+
+// =============================================================================
+// Reuse Tests
+// =============================================================================
+
+void test_first_request_opens_connection() {
+    TEST_ASSERT_FALSE(stats->record(CLIENT_A, 50000));
+    TEST_ASSERT_EQUAL(1, stats->getConnections());
+    TEST_ASSERT_EQUAL(0, stats->getReusePercent());
+}
+
+void test_same_endpoint_is_reuse() {
+    stats->record(CLIENT_A, 50000);
+
+    TEST_ASSERT_TRUE(stats->record(CLIENT_A, 50000));
+    TEST_ASSERT_EQUAL(1, stats->getReused());
+    TEST_ASSERT_EQUAL(50, stats->getReusePercent());
+}
+
+void test_new_port_is_new_connection() {
+    stats->record(CLIENT_A, 50000);
+
+    TEST_ASSERT_FALSE(stats->record(CLIENT_A, 50001));
+    TEST_ASSERT_FALSE(stats->record(CLIENT_B, 50000));
+    TEST_ASSERT_EQUAL(3, stats->getConnections());
+}
+
+void test_interleaved_connections_are_recognised() {
+    stats->record(CLIENT_A, 50000);
+    stats->record(CLIENT_B, 40000);
+
+    TEST_ASSERT_TRUE(stats->record(CLIENT_A, 50000));
+    TEST_ASSERT_TRUE(stats->record(CLIENT_B, 40000));
+}
+
+void test_oldest_connection_is_forgotten() {
+    for (uint16_t port = 1; port <= ConnectionStats::TRACKED_CONNECTIONS + 1; port++) {
+        stats->record(CLIENT_A, port);
+    }
+
+    TEST_ASSERT_FALSE(stats->record(CLIENT_A, 1));
+    TEST_ASSERT_TRUE(stats->record(CLIENT_A, ConnectionStats::TRACKED_CONNECTIONS + 1));
+}
+
+// =============================================================================
+// Test Runner
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Reuse
+    RUN_TEST(test_first_request_opens_connection);
+    RUN_TEST(test_same_endpoint_is_reuse);
+    RUN_TEST(test_new_port_is_new_connection);
+    RUN_TEST(test_interleaved_connections_are_recognised);
+    RUN_TEST(test_oldest_connection_is_forgotten);
+
+    return UNITY_END();
+}
@@ -0,0 +1,108 @@
+#include <unity.h>
+#include "control_command_queue.h"
+
+static ControlCommandQueue* queue;
+
+static ControlCommand target(float position) {
+    return {CONTROL_SET_TARGET, position, "Test"};
+}
+
+static ControlCommand stop() {
+    return {CONTROL_STOP, 0.0f, "Test"};
+}
+
+void setUp() {
+    queue = new ControlCommandQueue();
+}
+
+void tearDown() {
+    delete queue;
+}
+
+// =============================================================================
+// FIFO Tests
+// =============================================================================
+
+void test_initially_empty() {
+    ControlCommand command;
+
+    TEST_ASSERT_TRUE(queue->isEmpty());
+    TEST_ASSERT_FALSE(queue->pop(command));
+}
+
+void test_commands_come_out_in_order() {
+    ControlCommand command;
+    queue->push(target(50.0f));
+    queue->push(stop());
+
+    TEST_ASSERT_TRUE(queue->pop(command));
+    TEST_ASSERT_EQUAL(CONTROL_SET_TARGET, command.type);
+    TEST_ASSERT_EQUAL_FLOAT(50.0f, command.position);
+    TEST_ASSERT_TRUE(queue->pop(command));
+    TEST_ASSERT_EQUAL(CONTROL_STOP, command.type);
+    TEST_ASSERT_TRUE(queue->isEmpty());
+}
+
+void test_full_queue_rejects() {
+    for (size_t i = 0; i < ControlCommandQueue::CAPACITY; i++) {
+        TEST_ASSERT_TRUE(queue->push(stop()));
+    }
+
+    TEST_ASSERT_FALSE(queue->push(stop()));
+    TEST_ASSERT_EQUAL(1, queue->getRejectedCount());
+}
+
+void test_can_accept_matches_push() {
+    for (size_t i = 0; i < ControlCommandQueue::CAPACITY - 1; i++) {
+        queue->push(stop());
+    }
+    TEST_ASSERT_TRUE(queue->canAccept(stop()));
+    queue->push(target(10.0f));
+
+    TEST_ASSERT_FALSE(queue->canAccept(stop()));
+    TEST_ASSERT_TRUE(queue->canAccept(target(20.0f)));
+    TEST_ASSERT_EQUAL(0, queue->getRejectedCount());
+}
+
+// =============================================================================
+// Coalescing Tests
+// =============================================================================
+
+void test_consecutive_targets_keep_latest() {
+    ControlCommand command;
+    queue->push(target(10.0f));
+    queue->push(target(20.0f));
+    queue->push(target(30.0f));
+
+    TEST_ASSERT_EQUAL(1, queue->size());
+    queue->pop(command);
+    TEST_ASSERT_EQUAL_FLOAT(30.0f, command.position);
+}
+
+void test_stop_between_targets_is_kept() {
+    queue->push(target(10.0f));
+    queue->push(stop());
+    queue->push(target(30.0f));
+
+    TEST_ASSERT_EQUAL(3, queue->size());
+}
+
+// =============================================================================
+// Test Runner
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // FIFO
+    RUN_TEST(test_initially_empty);
+    RUN_TEST(test_commands_come_out_in_order);
+    RUN_TEST(test_full_queue_rejects);
+    RUN_TEST(test_can_accept_matches_push);
+
+    // Coalescing
+    RUN_TEST(test_consecutive_targets_keep_latest);
+    RUN_TEST(test_stop_between_targets_is_kept);
+
+    return UNITY_END();
+}
@@ -0,0 +1,147 @@
+#include <unity.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "html_template.h"
+
+// Collects every chunk handed to the sink
+struct MockSink {
+    std::string output;
+    std::vector<size_t> chunkSizes;
+
+    void operator()(const char* data, size_t length) {
+        output.append(data, length);
+        chunkSizes.push_back(length);
+    }
+};
+
+static MockSink* sink;
+
+void setUp() {
+    sink = new MockSink();
+}
+
+void tearDown() {
+    delete sink;
+}
+
+static auto readFrom(const char* text) {
+    size_t length = strlen(text);
+    return [text, length](size_t i) { return i < length ? text[i] : '\0'; };
+}
+
+static const char* resolveTestValues(const char* name, char* scratch, size_t scratchSize) {
+    if (strcmp(name, "ssid") == 0) {
+        return "Home \"5G\" <&>";
+    }
+    if (strcmp(name, "port") == 0) {
+        snprintf(scratch, scratchSize, "%u", 1883u);
+        return scratch;
+    }
+    return nullptr;
+}
+
+template<size_t N>
+static void render(HtmlTemplateWriter<N>& writer, const char* page) {
+    writer.render(readFrom(page), resolveTestValues, *sink);
+}
+
+// =============================================================================
+// Rendering Tests
+// =============================================================================
+
+void test_plain_text_is_copied() {
+    HtmlTemplateWriter<64> writer;
+    render(writer, "<p>width: 100%; {single}</p>");
+
+    TEST_ASSERT_EQUAL_STRING("<p>width: 100%; {single}</p>", sink->output.c_str());
+}
+
+void test_placeholders_are_replaced() {
+    HtmlTemplateWriter<64> writer;
+    render(writer, "<input value=\"{{port}}\">");
+
+    TEST_ASSERT_EQUAL_STRING("<input value=\"1883\">", sink->output.c_str());
+}
+
+void test_values_are_escaped() {
+    HtmlTemplateWriter<64> writer;
+    render(writer, "{{ssid}}");
+
+    TEST_ASSERT_EQUAL_STRING("Home &quot;5G&quot; &lt;&amp;&gt;", sink->output.c_str());
+}
+
+void test_unknown_placeholder_renders_empty() {
+    HtmlTemplateWriter<64> writer;
+    render(writer, "a{{missing}}b");
+
+    TEST_ASSERT_EQUAL_STRING("ab", sink->output.c_str());
+}
+
+void test_unterminated_placeholder_is_copied() {
+    HtmlTemplateWriter<64> writer;
+    render(writer, "a{{port");
+
+    TEST_ASSERT_EQUAL_STRING("a{{port", sink->output.c_str());
+}
+
+// =============================================================================
+// Chunking Tests
+// =============================================================================
+
+void test_output_is_split_into_buffer_sized_chunks() {
+    HtmlTemplateWriter<8> writer;
+    render(writer, "0123456789abcdefXYZ");
+
+    TEST_ASSERT_EQUAL_STRING("0123456789abcdefXYZ", sink->output.c_str());
+    TEST_ASSERT_EQUAL(3, sink->chunkSizes.size());
+    TEST_ASSERT_EQUAL(8, sink->chunkSizes[0]);
+    TEST_ASSERT_EQUAL(3, sink->chunkSizes[2]);
+    TEST_ASSERT_EQUAL(19, writer.getTotalWritten());
+}
+
+void test_value_spanning_chunks_is_intact() {
+    HtmlTemplateWriter<4> writer;
+    render(writer, "[{{ssid}}]");
+
+    TEST_ASSERT_EQUAL_STRING("[Home &quot;5G&quot; &lt;&amp;&gt;]", sink->output.c_str());
+}
+
+void test_render_step_resumes_where_it_stopped() {
+    HtmlTemplateWriter<8> writer;
+    const char* page = "0123456789{{port}}abcdef";
+    auto read = readFrom(page);
+    size_t position = 0;
+    bool done = false;
+    int steps = 0;
+
+    while (!done) {
+        position = writer.renderStep(read, resolveTestValues, *sink, position, done);
+        steps++;
+    }
+
+    TEST_ASSERT_EQUAL_STRING("01234567891883abcdef", sink->output.c_str());
+    TEST_ASSERT_EQUAL(3, steps);
+}
+
+// =============================================================================
+// Test Runner
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Rendering
+    RUN_TEST(test_plain_text_is_copied);
+    RUN_TEST(test_placeholders_are_replaced);
+    RUN_TEST(test_values_are_escaped);
+    RUN_TEST(test_unknown_placeholder_renders_empty);
+    RUN_TEST(test_unterminated_placeholder_is_copied);
+
+    // Chunking
+    RUN_TEST(test_output_is_split_into_buffer_sized_chunks);
+    RUN_TEST(test_value_spanning_chunks_is_intact);
+    RUN_TEST(test_render_step_resumes_where_it_stopped);
+
+    return UNITY_END();
+}
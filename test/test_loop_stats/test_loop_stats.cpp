@@ -0,0 +1,72 @@
+#include <unity.h>
+#include "loop_stats.h"
+
+static LoopStats* stats;
+
+void setUp() {
+    stats = new LoopStats();
+}
+
+void tearDown() {
+    delete stats;
+}
+
+// =============================================================================
+// Window Tests
+// =============================================================================
+
+void test_initially_zero() {
+    TEST_ASSERT_EQUAL(0, stats->getAverageUs());
+    TEST_ASSERT_EQUAL(0, stats->getMaxUs());
+}
+
+void test_average_and_max() {
+    stats->record(100);
+    stats->record(300);
+
+    TEST_ASSERT_EQUAL(200, stats->getAverageUs());
+    TEST_ASSERT_EQUAL(300, stats->getMaxUs());
+    TEST_ASSERT_EQUAL(2, stats->getWindowCount());
+}
+
+void test_reset_window_keeps_peak() {
+    stats->record(5000);
+    stats->resetWindow();
+    stats->record(100);
+
+    TEST_ASSERT_EQUAL(100, stats->getMaxUs());
+    TEST_ASSERT_EQUAL(5000, stats->getPeakUs());
+    TEST_ASSERT_EQUAL(2, stats->getTotalCount());
+}
+
+void test_sum_overflow_starts_new_window() {
+    stats->record(0xFFFFFFF0UL);
+    stats->record(100);
+
+    TEST_ASSERT_EQUAL(1, stats->getWindowCount());
+    TEST_ASSERT_EQUAL(100, stats->getAverageUs());
+}
+
+void test_total_time_does_not_overflow() {
+    stats->record(0xFFFFFFF0UL);
+    stats->record(0x20UL);
+
+    TEST_ASSERT_TRUE(stats->getTotalUs() == 0x100000010ULL);
+}
+
+// =============================================================================
+// Test Runner
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Window
+    RUN_TEST(test_initially_zero);
+    RUN_TEST(test_average_and_max);
+    RUN_TEST(test_reset_window_keeps_peak);
+    RUN_TEST(test_sum_overflow_starts_new_window);
+    RUN_TEST(test_total_time_does_not_overflow);
+
+    return UNITY_END();
+}
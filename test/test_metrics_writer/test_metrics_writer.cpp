@@ -0,0 +1,113 @@
+#include <unity.h>
+#include <string>
+#include <vector>
+#include "metrics_writer.h"
+
+// Collects every chunk handed to the sink
+struct MockSink {
+    std::string output;
+    std::vector<size_t> chunkSizes;
+
+    void operator()(const char* data, size_t length) {
+        output.append(data, length);
+        chunkSizes.push_back(length);
+    }
+};
+
+static MockSink* sink;
+
+void setUp() {
+    sink = new MockSink();
+}
+
+void tearDown() {
+    delete sink;
+}
+
+// =============================================================================
+// Format Tests
+// =============================================================================
+
+void test_family_writes_help_and_type() {
+    MetricsWriter<256> writer;
+    writer.family("awning_uptime_seconds", "counter", "Seconds since boot", *sink);
+    writer.flush(*sink);
+
+    TEST_ASSERT_EQUAL_STRING("# HELP awning_uptime_seconds Seconds since boot\n"
+                             "# TYPE awning_uptime_seconds counter\n", sink->output.c_str());
+}
+
+void test_integer_and_float_samples() {
+    MetricsWriter<256> writer;
+    writer.sample("a", nullptr, 4294967295UL, *sink);
+    writer.sample("b", nullptr, -67L, *sink);
+    writer.sample("c", nullptr, 42.5, *sink);
+    writer.flush(*sink);
+
+    TEST_ASSERT_EQUAL_STRING("a 4294967295\nb -67\nc 42.5\n", sink->output.c_str());
+}
+
+void test_labels_are_wrapped_in_braces() {
+    MetricsWriter<256> writer;
+    writer.sample("awning_task_max_us", "task=\"web\"", 1200UL, *sink);
+    writer.flush(*sink);
+
+    TEST_ASSERT_EQUAL_STRING("awning_task_max_us{task=\"web\"} 1200\n", sink->output.c_str());
+}
+
+void test_metric_combines_family_and_sample() {
+    MetricsWriter<256> writer;
+    writer.metric("awning_heap_free_bytes", "gauge", "Free heap", 30000UL, *sink);
+    writer.flush(*sink);
+
+    TEST_ASSERT_EQUAL_STRING("# HELP awning_heap_free_bytes Free heap\n"
+                             "# TYPE awning_heap_free_bytes gauge\n"
+                             "awning_heap_free_bytes 30000\n", sink->output.c_str());
+}
+
+// =============================================================================
+// Chunking Tests
+// =============================================================================
+
+void test_nothing_sent_before_buffer_fills() {
+    MetricsWriter<256> writer;
+    writer.sample("a", nullptr, 1UL, *sink);
+
+    TEST_ASSERT_EQUAL(0, sink->chunkSizes.size());
+}
+
+void test_lines_are_never_split_across_chunks() {
+    MetricsWriter<160> writer;
+    for (unsigned long i = 0; i < 20; i++) {
+        writer.sample("awning_metric_name", "label=\"value\"", i, *sink);
+    }
+    writer.flush(*sink);
+
+    TEST_ASSERT_TRUE(sink->chunkSizes.size() > 1);
+    size_t offset = 0;
+    for (size_t size : sink->chunkSizes) {
+        offset += size;
+        TEST_ASSERT_EQUAL('\n', sink->output[offset - 1]);
+    }
+    TEST_ASSERT_EQUAL(sink->output.size(), writer.getTotalWritten());
+}
+
+// =============================================================================
+// Test Runner
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Format
+    RUN_TEST(test_family_writes_help_and_type);
+    RUN_TEST(test_integer_and_float_samples);
+    RUN_TEST(test_labels_are_wrapped_in_braces);
+    RUN_TEST(test_metric_combines_family_and_sample);
+
+    // Chunking
+    RUN_TEST(test_nothing_sent_before_buffer_fills);
+    RUN_TEST(test_lines_are_never_split_across_chunks);
+
+    return UNITY_END();
+}
@@ -362,6 +362,25 @@ void test_update_without_time_provider_safe() {
     TEST_ASSERT_EQUAL(MOTOR_PULSE_IDLE, motor->getPulseState());
 }
 
+// =============================================================================
+// Relay Activation Tracking Tests
+// =============================================================================
+
+void test_activation_records_time_and_count() {
+    timeProvider->setTime(1234);
+    motor->requestStartPulse(PIN_RELAY_EXTEND);
+
+    TEST_ASSERT_EQUAL(1234, motor->getLastActivationTime());
+    TEST_ASSERT_EQUAL(1, motor->getActivationCount());
+}
+
+void test_rejected_pulse_is_not_counted() {
+    motor->requestStartPulse(PIN_RELAY_EXTEND);
+    motor->requestStartPulse(PIN_RELAY_RETRACT);  // Blocked by interlock
+
+    TEST_ASSERT_EQUAL(1, motor->getActivationCount());
+}
+
 // =============================================================================
 // Test Runner
 // =============================================================================
@@ -412,5 +431,9 @@ int main(int argc, char **argv) {
     // Edge cases
     RUN_TEST(test_update_without_time_provider_safe);
 
+    // Relay activation tracking
+    RUN_TEST(test_activation_records_time_and_count);
+    RUN_TEST(test_rejected_pulse_is_not_counted);
+
     return UNITY_END();
 }
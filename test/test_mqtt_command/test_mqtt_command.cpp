@@ -0,0 +1,195 @@
+#include <unity.h>
+#include <cstring>
+#include <functional>
+#include "mqtt_command.h"
+
+static const unsigned long NOW = 1729260000UL;
+static const unsigned long MAX_AGE = 120;
+
+static MqttCommand command;
+static char buffer[192];
+
+// Same callback members as MqttHandler
+struct TestHandlers {
+    std::function<CommandResult(const char*)> onCommand;
+    std::function<CommandResult(float)> onSetPosition;
+    std::function<CommandResult(float)> onSetWindThreshold;
+    std::function<CommandResult(const JsonCommand&)> onJsonCommand;
+};
+
+static CommandResult decode(MqttCommandTopic topic, const char* payload, unsigned long now = NOW) {
+    return decodeMqttCommand(topic, payload, strlen(payload), now, MAX_AGE, command);
+}
+
+static void assertRejected(const char* reason, CommandResult result) {
+    TEST_ASSERT_FALSE(result.accepted);
+    TEST_ASSERT_EQUAL_STRING(reason, result.reason);
+}
+
+void setUp() {
+    memset(&command, 0, sizeof(command));
+    buffer[0] = '\0';
+}
+
+void tearDown() {}
+
+// =============================================================================
+// Topic Tests
+// =============================================================================
+
+void test_command_topics_are_recognized() {
+    TEST_ASSERT_EQUAL(MQTT_COMMAND_SET, mqttCommandForTopic("home/awning/set", "home/awning"));
+    TEST_ASSERT_EQUAL(MQTT_COMMAND_SET_POSITION, mqttCommandForTopic("home/awning/set_position", "home/awning"));
+    TEST_ASSERT_EQUAL(MQTT_COMMAND_JSON, mqttCommandForTopic("home/awning/command", "home/awning"));
+}
+
+void test_other_topics_are_not_commands() {
+    TEST_ASSERT_EQUAL(MQTT_COMMAND_NONE, mqttCommandForTopic("home/awning/state", "home/awning"));
+    TEST_ASSERT_EQUAL(MQTT_COMMAND_NONE, mqttCommandForTopic("other/awning/set", "home/awning"));
+    TEST_ASSERT_EQUAL(MQTT_COMMAND_NONE, mqttCommandForTopic("homeassistant/status", "home/awning"));
+}
+
+// =============================================================================
+// Plain And Wrapped Payload Tests
+// =============================================================================
+
+void test_plain_payload_is_the_value() {
+    TEST_ASSERT_TRUE(decode(MQTT_COMMAND_SET, "OPEN").accepted);
+    TEST_ASSERT_EQUAL_STRING("OPEN", command.value);
+    TEST_ASSERT_NULL(command.getId());
+}
+
+void test_plain_position_must_be_a_number() {
+    TEST_ASSERT_TRUE(decode(MQTT_COMMAND_SET_POSITION, "42.5").accepted);
+    TEST_ASSERT_EQUAL_FLOAT(42.5f, command.number);
+
+    assertRejected("invalid_value", decode(MQTT_COMMAND_SET_POSITION, "abc"));
+    assertRejected("invalid_value", decode(MQTT_COMMAND_SET_POSITION, ""));
+}
+
+void test_wrapped_value_and_id_are_unwrapped() {
+    TEST_ASSERT_TRUE(decode(MQTT_COMMAND_SET, "{\"value\":\"CLOSE\",\"id\":\"abc\"}").accepted);
+    TEST_ASSERT_EQUAL_STRING("CLOSE", command.value);
+    TEST_ASSERT_EQUAL_STRING("\"abc\"", command.getId());
+
+    TEST_ASSERT_TRUE(decode(MQTT_COMMAND_SET_POSITION, "{ \"id\": 17, \"value\": 30 }").accepted);
+    TEST_ASSERT_EQUAL_FLOAT(30.0f, command.number);
+    TEST_ASSERT_EQUAL_STRING("17", command.getId());
+}
+
+void test_wrapper_without_usable_value_is_rejected() {
+    assertRejected("invalid_value", decode(MQTT_COMMAND_SET_POSITION, "{\"ts\":1729260000}"));
+    assertRejected("invalid_value", decode(MQTT_COMMAND_SET_POSITION, "{\"value\":null}"));
+    assertRejected("invalid_value", decode(MQTT_COMMAND_SET_POSITION, "{\"value\":true}"));
+    assertRejected("invalid_value", decode(MQTT_COMMAND_SET_POSITION, "{\"value\":{\"a\":1}}"));
+}
+
+void test_malformed_json_is_rejected() {
+    assertRejected("invalid_json", decode(MQTT_COMMAND_SET, "{\"value\":\"OPEN\""));
+    assertRejected("invalid_json", decode(MQTT_COMMAND_SET, "{\"value\":OPEN}"));
+    assertRejected("invalid_json", decode(MQTT_COMMAND_SET, "{\"value\":\"OPEN\"} x"));
+    assertRejected("invalid_json", decode(MQTT_COMMAND_JSON, "[1]"));
+}
+
+void test_long_id_is_rejected_not_truncated() {
+    assertRejected("invalid_id", decode(MQTT_COMMAND_SET, "{\"value\":\"OPEN\",\"id\":\"0123456789abcdefghijklmn\"}"));
+    TEST_ASSERT_NULL(command.getId());
+}
+
+void test_stale_command_is_rejected_once_clock_is_synced() {
+    assertRejected("stale", decode(MQTT_COMMAND_SET, "{\"value\":\"OPEN\",\"ts\":1729259000,\"id\":5}"));
+    TEST_ASSERT_EQUAL_STRING("5", command.getId());
+
+    TEST_ASSERT_TRUE(decode(MQTT_COMMAND_SET, "{\"value\":\"OPEN\",\"ts\":1729259000}", 0).accepted);
+    TEST_ASSERT_TRUE(decode(MQTT_COMMAND_SET, "{\"value\":\"OPEN\",\"ts\":1729259950}").accepted);
+}
+
+// =============================================================================
+// JSON Command Tests
+// =============================================================================
+
+void test_json_command_fields_are_read() {
+    TEST_ASSERT_TRUE(decode(MQTT_COMMAND_JSON, "{\"position\":40,\"wind_threshold\":120,\"id\":17}").accepted);
+    TEST_ASSERT_NULL(command.json.command);
+    TEST_ASSERT_TRUE(command.json.hasPosition);
+    TEST_ASSERT_EQUAL_FLOAT(40.0f, command.json.position);
+    TEST_ASSERT_TRUE(command.json.hasWindThreshold);
+    TEST_ASSERT_EQUAL_FLOAT(120.0f, command.json.windThreshold);
+
+    TEST_ASSERT_TRUE(decode(MQTT_COMMAND_JSON, "{\"command\":\"STOP\"}").accepted);
+    TEST_ASSERT_EQUAL_STRING("STOP", command.json.command);
+}
+
+void test_json_command_checks_types() {
+    assertRejected("invalid_type", decode(MQTT_COMMAND_JSON, "{\"command\":1}"));
+    assertRejected("invalid_type", decode(MQTT_COMMAND_JSON, "{\"position\":\"40\"}"));
+    assertRejected("invalid_type", decode(MQTT_COMMAND_JSON, "{\"wind_threshold\":[1]}"));
+    assertRejected("empty", decode(MQTT_COMMAND_JSON, "{\"id\":1}"));
+}
+
+// =============================================================================
+// Dispatch And Ack Tests
+// =============================================================================
+
+void test_dispatch_calls_the_matching_callback() {
+    TestHandlers handlers;
+    float received = -1.0f;
+    handlers.onSetPosition = [&received](float position) -> CommandResult {
+        received = position;
+        return {true, nullptr};
+    };
+
+    decode(MQTT_COMMAND_SET_POSITION, "55");
+    TEST_ASSERT_TRUE(dispatchMqttCommand(command, handlers).accepted);
+    TEST_ASSERT_EQUAL_FLOAT(55.0f, received);
+
+    decode(MQTT_COMMAND_SET, "OPEN");
+    assertRejected("unsupported", dispatchMqttCommand(command, handlers));
+}
+
+void test_accepted_ack_has_no_reason() {
+    formatMqttAck(buffer, sizeof(buffer), MQTT_COMMAND_SET, "17", {true, nullptr}, 3, 4);
+
+    TEST_ASSERT_EQUAL_STRING("{\"id\":17,\"cmd\":\"set\",\"result\":\"accepted\",\"latency_ms\":3,\"handled_ms\":4}",
+                             buffer);
+}
+
+void test_rejected_ack_has_reason_and_null_latency() {
+    formatMqttAck(buffer, sizeof(buffer), MQTT_COMMAND_SET_POSITION, nullptr, {false, "out_of_range"}, -1, 0);
+
+    TEST_ASSERT_EQUAL_STRING("{\"id\":null,\"cmd\":\"set_position\",\"result\":\"rejected\","
+                             "\"reason\":\"out_of_range\",\"latency_ms\":null,\"handled_ms\":0}",
+                             buffer);
+}
+
+// =============================================================================
+// Test Runner
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Topics
+    RUN_TEST(test_command_topics_are_recognized);
+    RUN_TEST(test_other_topics_are_not_commands);
+
+    // Plain and wrapped payloads
+    RUN_TEST(test_plain_payload_is_the_value);
+    RUN_TEST(test_plain_position_must_be_a_number);
+    RUN_TEST(test_wrapped_value_and_id_are_unwrapped);
+    RUN_TEST(test_wrapper_without_usable_value_is_rejected);
+    RUN_TEST(test_malformed_json_is_rejected);
+    RUN_TEST(test_long_id_is_rejected_not_truncated);
+    RUN_TEST(test_stale_command_is_rejected_once_clock_is_synced);
+
+    // JSON command
+    RUN_TEST(test_json_command_fields_are_read);
+    RUN_TEST(test_json_command_checks_types);
+
+    // Dispatch and ack
+    RUN_TEST(test_dispatch_calls_the_matching_callback);
+    RUN_TEST(test_accepted_ack_has_no_reason);
+    RUN_TEST(test_rejected_ack_has_reason_and_null_latency);
+
+    return UNITY_END();
+}
@@ -0,0 +1,207 @@
+#include <unity.h>
+#include <string>
+#include <vector>
+#include "mqtt_outbound_queue.h"
+
+// Records every publish and can simulate a dead connection
+struct MockPublisher {
+    std::vector<std::string> topics;
+    std::vector<std::string> payloads;
+    bool connected = true;
+
+    bool operator()(const char* topic, const char* payload, bool retained) {
+        (void)retained;
+        if (!connected) {
+            return false;
+        }
+        topics.push_back(topic);
+        payloads.push_back(payload);
+        return true;
+    }
+};
+
+static const char STATE_TOPIC[] = "home/awning/state";
+static const char POSITION_TOPIC[] = "home/awning/position";
+static const char EVENT_TOPIC[] = "home/awning/event";
+
+static MqttOutboundQueue* queue;
+static MockPublisher* publisher;
+
+void setUp() {
+    queue = new MqttOutboundQueue();
+    publisher = new MockPublisher();
+}
+
+void tearDown() {
+    delete publisher;
+    delete queue;
+}
+
+// Lambda wrapper so the queue can take the mock by reference
+static size_t flushAt(unsigned long now) {
+    return queue->flush(now, [](const char* t, const char* p, bool r) { return (*publisher)(t, p, r); });
+}
+
+// =============================================================================
+// Enqueue Tests
+// =============================================================================
+
+void test_initially_empty() {
+    TEST_ASSERT_TRUE(queue->isEmpty());
+    TEST_ASSERT_EQUAL(0, queue->size());
+}
+
+void test_state_is_latest_wins_per_topic() {
+    queue->enqueueState(STATE_TOPIC, "opening", true);
+    queue->enqueueState(STATE_TOPIC, "open", true);
+
+    TEST_ASSERT_EQUAL(1, queue->size());
+    TEST_ASSERT_EQUAL_STRING("open", queue->peek(0)->payload);
+}
+
+void test_different_state_topics_are_kept() {
+    queue->enqueueState(STATE_TOPIC, "open", true);
+    queue->enqueueState(POSITION_TOPIC, "100.0", true);
+
+    TEST_ASSERT_EQUAL(2, queue->size());
+}
+
+void test_events_are_appended() {
+    queue->enqueueEvent(EVENT_TOPIC, "a", false, false);
+    queue->enqueueEvent(EVENT_TOPIC, "b", false, false);
+
+    TEST_ASSERT_EQUAL(2, queue->size());
+    TEST_ASSERT_EQUAL_STRING("a", queue->peek(0)->payload);
+    TEST_ASSERT_EQUAL_STRING("b", queue->peek(1)->payload);
+}
+
+void test_long_payload_is_truncated() {
+    std::string longPayload(200, 'x');
+    queue->enqueueEvent(EVENT_TOPIC, longPayload.c_str(), false, false);
+
+    TEST_ASSERT_EQUAL(OutboundMessage::PAYLOAD_SIZE - 1, strlen(queue->peek(0)->payload));
+}
+
+// =============================================================================
+// Overflow Tests
+// =============================================================================
+
+void test_overflow_drops_oldest_unimportant() {
+    queue->enqueueEvent(EVENT_TOPIC, "important", false, true);
+    for (size_t i = 0; i < MqttOutboundQueue::CAPACITY; i++) {
+        queue->enqueueEvent(EVENT_TOPIC, "filler", false, false);
+    }
+
+    TEST_ASSERT_EQUAL(MqttOutboundQueue::CAPACITY, queue->size());
+    TEST_ASSERT_EQUAL(1, queue->getDroppedCount());
+    TEST_ASSERT_EQUAL_STRING("important", queue->peek(0)->payload);
+}
+
+void test_overflow_with_only_important_drops_oldest() {
+    queue->enqueueEvent(EVENT_TOPIC, "first", false, true);
+    for (size_t i = 0; i < MqttOutboundQueue::CAPACITY; i++) {
+        queue->enqueueEvent(EVENT_TOPIC, "later", false, true);
+    }
+
+    TEST_ASSERT_EQUAL(MqttOutboundQueue::CAPACITY, queue->size());
+    TEST_ASSERT_EQUAL_STRING("later", queue->peek(0)->payload);
+}
+
+// =============================================================================
+// Flush Tests
+// =============================================================================
+
+void test_flush_publishes_in_order_and_removes() {
+    queue->enqueueState(STATE_TOPIC, "open", true);
+    queue->enqueueEvent(EVENT_TOPIC, "evt", false, false);
+
+    TEST_ASSERT_EQUAL(2, flushAt(0));
+    TEST_ASSERT_TRUE(queue->isEmpty());
+    TEST_ASSERT_EQUAL_STRING(STATE_TOPIC, publisher->topics[0].c_str());
+    TEST_ASSERT_EQUAL_STRING(EVENT_TOPIC, publisher->topics[1].c_str());
+}
+
+void test_flush_respects_burst_and_interval() {
+    queue->setRateLimit(2, 100);
+    for (int i = 0; i < 5; i++) {
+        queue->enqueueEvent(EVENT_TOPIC, "evt", false, false);
+    }
+
+    TEST_ASSERT_EQUAL(2, flushAt(1000));
+    TEST_ASSERT_EQUAL(0, flushAt(1050));
+    TEST_ASSERT_EQUAL(2, flushAt(1100));
+    TEST_ASSERT_EQUAL(1, flushAt(1200));
+    TEST_ASSERT_TRUE(queue->isEmpty());
+}
+
+void test_failed_publish_keeps_message() {
+    queue->enqueueState(STATE_TOPIC, "open", true);
+    publisher->connected = false;
+
+    TEST_ASSERT_EQUAL(0, flushAt(0));
+    TEST_ASSERT_EQUAL(1, queue->size());
+}
+
+// =============================================================================
+// Important Message (ack window) Tests
+// =============================================================================
+
+void test_important_message_stays_inflight_until_settled() {
+    queue->enqueueEvent(EVENT_TOPIC, "wind", false, true);
+    flushAt(0);
+
+    TEST_ASSERT_EQUAL(1, queue->getInflightCount());
+    queue->settle(1000, 5000);
+    TEST_ASSERT_EQUAL(1, queue->size());
+    queue->settle(5000, 5000);
+    TEST_ASSERT_TRUE(queue->isEmpty());
+}
+
+void test_inflight_is_not_published_twice() {
+    queue->enqueueEvent(EVENT_TOPIC, "wind", false, true);
+    flushAt(0);
+    flushAt(1000);
+
+    TEST_ASSERT_EQUAL(1, publisher->topics.size());
+}
+
+void test_connection_lost_resends_inflight() {
+    queue->enqueueEvent(EVENT_TOPIC, "wind", false, true);
+    flushAt(0);
+    queue->onConnectionLost();
+
+    TEST_ASSERT_EQUAL(1, queue->getPendingCount());
+    flushAt(1000);
+    TEST_ASSERT_EQUAL(2, publisher->topics.size());
+}
+
+// =============================================================================
+// Test Runner
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Enqueue
+    RUN_TEST(test_initially_empty);
+    RUN_TEST(test_state_is_latest_wins_per_topic);
+    RUN_TEST(test_different_state_topics_are_kept);
+    RUN_TEST(test_events_are_appended);
+    RUN_TEST(test_long_payload_is_truncated);
+
+    // Overflow
+    RUN_TEST(test_overflow_drops_oldest_unimportant);
+    RUN_TEST(test_overflow_with_only_important_drops_oldest);
+
+    // Flush
+    RUN_TEST(test_flush_publishes_in_order_and_removes);
+    RUN_TEST(test_flush_respects_burst_and_interval);
+    RUN_TEST(test_failed_publish_keeps_message);
+
+    // Important messages
+    RUN_TEST(test_important_message_stays_inflight_until_settled);
+    RUN_TEST(test_inflight_is_not_published_twice);
+    RUN_TEST(test_connection_lost_resends_inflight);
+
+    return UNITY_END();
+}
@@ -0,0 +1,126 @@
+#include <unity.h>
+#include "ota_session.h"
+
+static OtaSession* session;
+
+void setUp() {
+    session = new OtaSession();
+}
+
+void tearDown() {
+    delete session;
+}
+
+// =============================================================================
+// Validation Tests
+// =============================================================================
+
+void test_md5_must_be_32_hex_digits() {
+    TEST_ASSERT_TRUE(OtaSession::isValidMd5("0123456789abcdefABCDEF0123456789"));
+    TEST_ASSERT_FALSE(OtaSession::isValidMd5("0123456789abcdef0123456789abcde"));
+    TEST_ASSERT_FALSE(OtaSession::isValidMd5("0123456789abcdef0123456789abcdef0"));
+    TEST_ASSERT_FALSE(OtaSession::isValidMd5("0123456789abcdefg123456789abcdef"));
+    TEST_ASSERT_FALSE(OtaSession::isValidMd5(""));
+    TEST_ASSERT_FALSE(OtaSession::isValidMd5(nullptr));
+}
+
+// =============================================================================
+// Progress Tests
+// =============================================================================
+
+void test_begin_starts_receiving() {
+    TEST_ASSERT_FALSE(session->isActive());
+    session->begin(1000, 400000);
+
+    TEST_ASSERT_TRUE(session->isActive());
+    TEST_ASSERT_EQUAL_STRING("receiving", OtaSession::stateName(session->getState()));
+    TEST_ASSERT_EQUAL(0, session->getReceived());
+}
+
+void test_throughput_and_percent() {
+    session->begin(1000, 400000);
+    session->onData(100000, 3000);
+    session->onData(100000, 5000);
+
+    TEST_ASSERT_EQUAL(200000, session->getReceived());
+    TEST_ASSERT_EQUAL(50, session->getPercent());
+    TEST_ASSERT_EQUAL(4000, session->getElapsedMs());
+    TEST_ASSERT_EQUAL(50000, session->getThroughputBps());
+}
+
+void test_unknown_size_reports_no_percent() {
+    session->begin(0, 0);
+    session->onData(1000, 10);
+
+    TEST_ASSERT_EQUAL(0, session->getPercent());
+}
+
+void test_first_failure_is_kept() {
+    session->begin(0, 1000);
+    session->fail("write_failed", 50);
+    session->fail("aborted", 60);
+    session->succeed(70);
+
+    TEST_ASSERT_EQUAL(OTA_FAILED, session->getState());
+    TEST_ASSERT_EQUAL_STRING("write_failed", session->getError());
+    TEST_ASSERT_EQUAL(50, session->getElapsedMs());
+}
+
+void test_data_after_end_is_ignored() {
+    session->begin(0, 1000);
+    session->onData(1000, 100);
+    session->succeed(100);
+    session->onData(500, 200);
+
+    TEST_ASSERT_EQUAL(1000, session->getReceived());
+    TEST_ASSERT_EQUAL(100, session->getElapsedMs());
+}
+
+// =============================================================================
+// Safety Gap Tests
+// =============================================================================
+
+void test_safety_gaps_are_measured_between_ticks() {
+    session->begin(0, 1000);
+    session->onSafetyTick(10000);
+    session->onSafetyTick(12000);
+    session->onSafetyTick(20000);
+
+    TEST_ASSERT_EQUAL(2, session->getSafetyGaps().getWindowCount());
+    TEST_ASSERT_EQUAL(8000, session->getSafetyGaps().getMaxUs());
+    TEST_ASSERT_EQUAL(5000, session->getSafetyGaps().getAverageUs());
+}
+
+void test_new_upload_resets_gaps() {
+    session->begin(0, 1000);
+    session->onSafetyTick(0);
+    session->onSafetyTick(50000);
+    session->begin(100, 1000);
+    session->onSafetyTick(200000);
+
+    TEST_ASSERT_EQUAL(0, session->getSafetyGaps().getWindowCount());
+}
+
+// =============================================================================
+// Test Runner
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Validation
+    RUN_TEST(test_md5_must_be_32_hex_digits);
+
+    // Progress
+    RUN_TEST(test_begin_starts_receiving);
+    RUN_TEST(test_throughput_and_percent);
+    RUN_TEST(test_unknown_size_reports_no_percent);
+    RUN_TEST(test_first_failure_is_kept);
+    RUN_TEST(test_data_after_end_is_ignored);
+
+    // Safety gaps
+    RUN_TEST(test_safety_gaps_are_measured_between_ticks);
+    RUN_TEST(test_new_upload_resets_gaps);
+
+    return UNITY_END();
+}
@@ -0,0 +1,95 @@
+#include <unity.h>
+#include <cstring>
+#include "rtc_record.h"
+
+struct TestPayload {
+    float position;
+    uint32_t counter;
+};
+
+static const uint32_t TEST_MAGIC = 0x52544331;
+
+static RtcRecord<TestPayload> record;
+
+void setUp() {
+    memset(&record, 0xA5, sizeof(record));
+}
+
+void tearDown() {}
+
+// =============================================================================
+// CRC Tests
+// =============================================================================
+
+void test_crc32_check_value() {
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926, rtcCrc32("123456789", 9));
+}
+
+void test_crc32_can_be_chained() {
+    uint32_t crc = rtcCrc32("12345", 5);
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926, rtcCrc32("6789", 4, crc));
+}
+
+// =============================================================================
+// Record Tests
+// =============================================================================
+
+void test_uninitialized_memory_is_invalid() {
+    TEST_ASSERT_FALSE(record.isValid(TEST_MAGIC));
+}
+
+void test_sealed_record_is_valid() {
+    record.payload.position = 42.5f;
+    record.payload.counter = 7;
+    record.seal(TEST_MAGIC);
+
+    TEST_ASSERT_TRUE(record.isValid(TEST_MAGIC));
+}
+
+void test_other_magic_is_invalid() {
+    record.payload.counter = 7;
+    record.seal(TEST_MAGIC);
+
+    TEST_ASSERT_FALSE(record.isValid(TEST_MAGIC + 1));
+}
+
+void test_corrupted_payload_is_invalid() {
+    record.payload.counter = 7;
+    record.seal(TEST_MAGIC);
+    record.payload.counter = 8;
+
+    TEST_ASSERT_FALSE(record.isValid(TEST_MAGIC));
+}
+
+void test_invalidate() {
+    record.seal(TEST_MAGIC);
+    record.invalidate();
+
+    TEST_ASSERT_FALSE(record.isValid(TEST_MAGIC));
+}
+
+void test_size_is_whole_blocks() {
+    TEST_ASSERT_EQUAL(0, sizeof(record) % 4);
+}
+
+// =============================================================================
+// Test Runner
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // CRC
+    RUN_TEST(test_crc32_check_value);
+    RUN_TEST(test_crc32_can_be_chained);
+
+    // Record
+    RUN_TEST(test_uninitialized_memory_is_invalid);
+    RUN_TEST(test_sealed_record_is_valid);
+    RUN_TEST(test_other_magic_is_invalid);
+    RUN_TEST(test_corrupted_payload_is_invalid);
+    RUN_TEST(test_invalidate);
+    RUN_TEST(test_size_is_whole_blocks);
+
+    return UNITY_END();
+}
@@ -0,0 +1,167 @@
+#include <unity.h>
+#include <cstring>
+#include "status_cache.h"
+
+static StatusCache<256>* cache;
+static StatusSnapshot status;
+
+static StatusSnapshot makeStatus() {
+    StatusSnapshot snapshot;
+    snapshot.position = 42.5f;
+    snapshot.target = 100.0f;
+    snapshot.motor = AWNING_EXTENDING;
+    snapshot.windPulses = 12;
+    snapshot.windThreshold = 100;
+    snapshot.travelTime = 15000;
+    snapshot.calibrating = false;
+    return snapshot;
+}
+
+void setUp() {
+    cache = new StatusCache<256>();
+    status = makeStatus();
+}
+
+void tearDown() {
+    delete cache;
+}
+
+// Position of a CBOR text string key in the encoded map
+static const uint8_t* findKey(const uint8_t* data, size_t length, const char* key) {
+    size_t keyLength = strlen(key);
+    for (size_t i = 0; i + keyLength < length; i++) {
+        if (data[i] == (0x60 | keyLength) && memcmp(data + i + 1, key, keyLength) == 0) {
+            return data + i + 1 + keyLength;
+        }
+    }
+    return nullptr;
+}
+
+// =============================================================================
+// CBOR Tests
+// =============================================================================
+
+void test_cbor_map_has_all_fields() {
+    uint8_t buffer[128];
+    size_t length = encodeStatusCbor(status, buffer, sizeof(buffer));
+
+    TEST_ASSERT_TRUE(length > 0);
+    TEST_ASSERT_EQUAL_HEX8(0xA7, buffer[0]);
+    const char* keys[] = {"position", "target", "motor", "windPulses", "windThreshold", "travelTime", "calibrating"};
+    for (const char* key : keys) {
+        TEST_ASSERT_NOT_NULL(findKey(buffer, length, key));
+    }
+}
+
+void test_cbor_value_encodings() {
+    uint8_t buffer[128];
+    size_t length = encodeStatusCbor(status, buffer, sizeof(buffer));
+
+    // 42.5f as single precision
+    const uint8_t position[] = {0xFA, 0x42, 0x2A, 0x00, 0x00};
+    TEST_ASSERT_EQUAL_MEMORY(position, findKey(buffer, length, "position"), sizeof(position));
+    // Small integer in the initial byte, larger one with a 2-byte argument
+    TEST_ASSERT_EQUAL_HEX8(0x0C, *findKey(buffer, length, "windPulses"));
+    const uint8_t travelTime[] = {0x19, 0x3A, 0x98};
+    TEST_ASSERT_EQUAL_MEMORY(travelTime, findKey(buffer, length, "travelTime"), sizeof(travelTime));
+    const uint8_t motor[] = {0x69, 'E', 'x', 't', 'e', 'n', 'd', 'i', 'n', 'g'};
+    TEST_ASSERT_EQUAL_MEMORY(motor, findKey(buffer, length, "motor"), sizeof(motor));
+    TEST_ASSERT_EQUAL_HEX8(0xF4, *findKey(buffer, length, "calibrating"));
+}
+
+void test_cbor_position_is_rounded_like_json() {
+    uint8_t a[128];
+    uint8_t b[128];
+    status.position = 42.51f;
+    size_t lengthA = encodeStatusCbor(status, a, sizeof(a));
+    status.position = 42.5f;
+    size_t lengthB = encodeStatusCbor(status, b, sizeof(b));
+
+    TEST_ASSERT_EQUAL(lengthA, lengthB);
+    TEST_ASSERT_EQUAL_MEMORY(a, b, lengthA);
+}
+
+void test_cbor_small_buffer_produces_nothing() {
+    uint8_t buffer[16];
+
+    TEST_ASSERT_EQUAL(0, encodeStatusCbor(status, buffer, sizeof(buffer)));
+}
+
+// =============================================================================
+// Cache Tests
+// =============================================================================
+
+void test_cache_encodes_full_status() {
+    StatusDeltaEncoder encoder;
+    char expected[256];
+    size_t length;
+    const char* json = cache->getJson(status, length);
+
+    encoder.encodeFull(status, expected, sizeof(expected));
+    TEST_ASSERT_EQUAL_STRING(expected, json);
+    TEST_ASSERT_EQUAL(strlen(expected), length);
+    TEST_ASSERT_EQUAL(1, cache->getVersion());
+}
+
+void test_cache_reuses_unchanged_status() {
+    size_t length;
+    cache->getJson(status, length);
+    status.position = 42.52f;
+
+    cache->getJson(status, length);
+    TEST_ASSERT_EQUAL(1, cache->getVersion());
+}
+
+void test_cache_reencodes_changed_status() {
+    size_t length;
+    cache->getJson(status, length);
+    status.windPulses = 13;
+
+    const char* json = cache->getJson(status, length);
+    TEST_ASSERT_EQUAL(2, cache->getVersion());
+    TEST_ASSERT_NOT_NULL(strstr(json, "\"windPulses\":13"));
+}
+
+void test_cache_formats_share_version() {
+    size_t jsonLength;
+    size_t cborLength;
+    cache->getJson(status, jsonLength);
+    const uint8_t* cbor = cache->getCbor(status, cborLength);
+
+    uint8_t expected[128];
+    TEST_ASSERT_EQUAL(encodeStatusCbor(status, expected, sizeof(expected)), cborLength);
+    TEST_ASSERT_EQUAL_MEMORY(expected, cbor, cborLength);
+    TEST_ASSERT_EQUAL(1, cache->getVersion());
+}
+
+void test_cache_cbor_follows_changes() {
+    size_t length;
+    cache->getCbor(status, length);
+    status.calibrating = true;
+
+    const uint8_t* cbor = cache->getCbor(status, length);
+    TEST_ASSERT_EQUAL_HEX8(0xF5, *findKey(cbor, length, "calibrating"));
+}
+
+// =============================================================================
+// Test Runner
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // CBOR
+    RUN_TEST(test_cbor_map_has_all_fields);
+    RUN_TEST(test_cbor_value_encodings);
+    RUN_TEST(test_cbor_position_is_rounded_like_json);
+    RUN_TEST(test_cbor_small_buffer_produces_nothing);
+
+    // Cache
+    RUN_TEST(test_cache_encodes_full_status);
+    RUN_TEST(test_cache_reuses_unchanged_status);
+    RUN_TEST(test_cache_reencodes_changed_status);
+    RUN_TEST(test_cache_formats_share_version);
+    RUN_TEST(test_cache_cbor_follows_changes);
+
+    return UNITY_END();
+}
@@ -0,0 +1,136 @@
+#include <unity.h>
+#include <cstring>
+#include "status_delta.h"
+
+static StatusDeltaEncoder* encoder;
+static StatusSnapshot status;
+static char buffer[256];
+
+static StatusSnapshot makeStatus() {
+    StatusSnapshot snapshot;
+    snapshot.position = 42.5f;
+    snapshot.target = 100.0f;
+    snapshot.motor = AWNING_EXTENDING;
+    snapshot.windPulses = 12;
+    snapshot.windThreshold = 100;
+    snapshot.travelTime = 15000;
+    snapshot.calibrating = false;
+    return snapshot;
+}
+
+void setUp() {
+    encoder = new StatusDeltaEncoder();
+    status = makeStatus();
+    buffer[0] = '\0';
+}
+
+void tearDown() {
+    delete encoder;
+}
+
+// =============================================================================
+// Encoding Tests
+// =============================================================================
+
+void test_first_delta_contains_all_fields() {
+    encoder->encodeDelta(status, 0, buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL_STRING("{\"position\":42.5,\"target\":100.0,\"motor\":\"Extending\","
+                             "\"windPulses\":12,\"windThreshold\":100,\"travelTime\":15000,"
+                             "\"calibrating\":false}", buffer);
+}
+
+void test_unchanged_status_produces_nothing() {
+    encoder->encodeDelta(status, 0, buffer, sizeof(buffer));
+
+    TEST_ASSERT_EQUAL(0, encoder->encodeDelta(status, 100, buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("", buffer);
+}
+
+void test_delta_contains_only_changed_fields() {
+    encoder->encodeDelta(status, 0, buffer, sizeof(buffer));
+    status.position = 43.0f;
+    status.windPulses = 15;
+
+    encoder->encodeDelta(status, 250, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL_STRING("{\"position\":43.0,\"windPulses\":15}", buffer);
+}
+
+void test_position_change_below_display_resolution_is_ignored() {
+    encoder->encodeDelta(status, 0, buffer, sizeof(buffer));
+    status.position = 42.52f;
+
+    TEST_ASSERT_EQUAL(0, encoder->encodeDelta(status, 250, buffer, sizeof(buffer)));
+}
+
+void test_full_snapshot_does_not_affect_delta() {
+    encoder->encodeDelta(status, 0, buffer, sizeof(buffer));
+    status.motor = AWNING_IDLE;
+
+    encoder->encodeFull(status, buffer, sizeof(buffer));
+    TEST_ASSERT_NOT_NULL(strstr(buffer, "\"motor\":\"Idle\""));
+
+    encoder->encodeDelta(status, 100, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL_STRING("{\"motor\":\"Idle\"}", buffer);
+}
+
+void test_small_buffer_produces_nothing() {
+    char small[20];
+
+    TEST_ASSERT_EQUAL(0, encoder->encodeDelta(status, 0, small, sizeof(small)));
+    TEST_ASSERT_EQUAL_STRING("", small);
+}
+
+// =============================================================================
+// Rate Limit Tests
+// =============================================================================
+
+void test_first_push_is_due() {
+    TEST_ASSERT_TRUE(encoder->isDue(0, status, 250, 1000));
+}
+
+void test_motion_uses_fast_interval() {
+    encoder->encodeDelta(status, 1000, buffer, sizeof(buffer));
+
+    TEST_ASSERT_FALSE(encoder->isDue(1200, status, 250, 1000));
+    TEST_ASSERT_TRUE(encoder->isDue(1250, status, 250, 1000));
+}
+
+void test_idle_uses_slow_interval() {
+    status.motor = AWNING_IDLE;
+    encoder->encodeDelta(status, 1000, buffer, sizeof(buffer));
+
+    TEST_ASSERT_FALSE(encoder->isDue(1500, status, 250, 1000));
+    TEST_ASSERT_TRUE(encoder->isDue(2000, status, 250, 1000));
+}
+
+void test_motor_state_change_is_due_immediately() {
+    encoder->encodeDelta(status, 1000, buffer, sizeof(buffer));
+    status.motor = AWNING_IDLE;
+
+    TEST_ASSERT_TRUE(encoder->isDue(1010, status, 250, 1000));
+}
+
+// =============================================================================
+// Test Runner
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Encoding
+    RUN_TEST(test_first_delta_contains_all_fields);
+    RUN_TEST(test_unchanged_status_produces_nothing);
+    RUN_TEST(test_delta_contains_only_changed_fields);
+    RUN_TEST(test_position_change_below_display_resolution_is_ignored);
+    RUN_TEST(test_full_snapshot_does_not_affect_delta);
+    RUN_TEST(test_small_buffer_produces_nothing);
+
+    // Rate limit
+    RUN_TEST(test_first_push_is_due);
+    RUN_TEST(test_motion_uses_fast_interval);
+    RUN_TEST(test_idle_uses_slow_interval);
+    RUN_TEST(test_motor_state_change_is_due_immediately);
+
+    return UNITY_END();
+}
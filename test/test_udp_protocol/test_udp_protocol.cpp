@@ -0,0 +1,109 @@
+#include <unity.h>
+#include "udp_protocol.h"
+
+static UdpSequenceTracker* tracker;
+
+static const uint32_t CLIENT_A = 0x0A00000A;
+static const uint32_t CLIENT_B = 0x0B00000A;
+
+void setUp() {
+    tracker = new UdpSequenceTracker();
+}
+
+void tearDown() {
+    delete tracker;
+}
+
+// =============================================================================
+// Packet Tests
+// =============================================================================
+
+void test_parse_set_position() {
+    const uint8_t packet[] = {'A', 'W', 1, UDP_SET_POSITION, 0x12, 0x34, 0x01, 0xF4};
+    UdpRequest request;
+
+    TEST_ASSERT_TRUE(parseUdpRequest(packet, sizeof(packet), request));
+    TEST_ASSERT_EQUAL(UDP_SET_POSITION, request.type);
+    TEST_ASSERT_EQUAL(0x1234, request.sequence);
+    TEST_ASSERT_EQUAL(500, request.argument);
+}
+
+void test_parse_rejects_malformed_packets() {
+    const uint8_t badMagic[] = {'X', 'W', 1, UDP_STATUS, 0, 1, 0, 0};
+    const uint8_t badVersion[] = {'A', 'W', 2, UDP_STATUS, 0, 1, 0, 0};
+    const uint8_t shortPacket[] = {'A', 'W', 1, UDP_STATUS, 0, 1};
+    UdpRequest request;
+
+    TEST_ASSERT_FALSE(parseUdpRequest(badMagic, sizeof(badMagic), request));
+    TEST_ASSERT_FALSE(parseUdpRequest(badVersion, sizeof(badVersion), request));
+    TEST_ASSERT_FALSE(parseUdpRequest(shortPacket, sizeof(shortPacket), request));
+}
+
+void test_encode_response() {
+    UdpRequest request = {UDP_STATUS, 0xBEEF, 0};
+    UdpStatus status = {1, 425, 1000, 300, UDP_FLAG_CALIBRATING};
+    uint8_t out[UDP_RESPONSE_SIZE];
+    encodeUdpResponse(request, UDP_OK, status, out);
+
+    const uint8_t expected[] = {'A', 'W', 1, 0x81, 0xBE, 0xEF, UDP_OK, 1,
+                                0x01, 0xA9, 0x03, 0xE8, 0x01, 0x2C, 0x01, 0x00};
+    TEST_ASSERT_EQUAL_MEMORY(expected, out, sizeof(expected));
+}
+
+// =============================================================================
+// Sequence Tests
+// =============================================================================
+
+void test_new_sequence_is_not_duplicate() {
+    uint8_t result;
+    tracker->record(CLIENT_A, 5000, 1, UDP_OK);
+
+    TEST_ASSERT_FALSE(tracker->isDuplicate(CLIENT_A, 5000, 2, result));
+}
+
+void test_repeated_sequence_returns_original_result() {
+    uint8_t result = UDP_OK;
+    tracker->record(CLIENT_A, 5000, 7, UDP_BUSY);
+
+    TEST_ASSERT_TRUE(tracker->isDuplicate(CLIENT_A, 5000, 7, result));
+    TEST_ASSERT_EQUAL(UDP_BUSY, result);
+}
+
+void test_clients_are_tracked_separately() {
+    uint8_t result;
+    tracker->record(CLIENT_A, 5000, 7, UDP_OK);
+
+    TEST_ASSERT_FALSE(tracker->isDuplicate(CLIENT_B, 5000, 7, result));
+    TEST_ASSERT_FALSE(tracker->isDuplicate(CLIENT_A, 5001, 7, result));
+}
+
+void test_oldest_client_is_replaced() {
+    uint8_t result;
+    for (uint16_t port = 1; port <= UdpSequenceTracker::MAX_CLIENTS + 1; port++) {
+        tracker->record(CLIENT_A, port, 9, UDP_OK);
+    }
+
+    TEST_ASSERT_FALSE(tracker->isDuplicate(CLIENT_A, 1, 9, result));
+    TEST_ASSERT_TRUE(tracker->isDuplicate(CLIENT_A, 2, 9, result));
+}
+
+// =============================================================================
+// Test Runner
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Packets
+    RUN_TEST(test_parse_set_position);
+    RUN_TEST(test_parse_rejects_malformed_packets);
+    RUN_TEST(test_encode_response);
+
+    // Sequences
+    RUN_TEST(test_new_sequence_is_not_duplicate);
+    RUN_TEST(test_repeated_sequence_returns_original_result);
+    RUN_TEST(test_clients_are_tracked_separately);
+    RUN_TEST(test_oldest_client_is_replaced);
+
+    return UNITY_END();
+}
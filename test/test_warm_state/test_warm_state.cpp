@@ -0,0 +1,114 @@
+#include <unity.h>
+#include "warm_state.h"
+
+static WarmState saved;
+
+static const unsigned long TRAVEL_TIME_MS = 20000;  // 5% per second
+
+void setUp() {
+    saved.position = 40.0f;
+    saved.target = 40.0f;
+    saved.state = AWNING_IDLE;
+    saved.movementStartTicks = 0;
+    saved.positionTicks = 0;
+}
+
+void tearDown() {}
+
+// =============================================================================
+// Idle Tests
+// =============================================================================
+
+void test_idle_position_is_restored() {
+    WarmRecovery result = recoverWarmState(saved, 5000, TRAVEL_TIME_MS);
+
+    TEST_ASSERT_EQUAL(AWNING_IDLE, result.state);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 40.0f, result.position);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 40.0f, result.target);
+}
+
+void test_idle_position_does_not_need_the_clock() {
+    WarmRecovery result = recoverWarmState(saved, WARM_STATE_ELAPSED_UNKNOWN, TRAVEL_TIME_MS);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 40.0f, result.position);
+}
+
+// =============================================================================
+// Movement Tests
+// =============================================================================
+
+void test_extending_is_extrapolated_and_resumed() {
+    saved.state = AWNING_EXTENDING;
+    saved.target = 80.0f;
+    WarmRecovery result = recoverWarmState(saved, 2000, TRAVEL_TIME_MS);
+
+    TEST_ASSERT_EQUAL(AWNING_EXTENDING, result.state);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 50.0f, result.position);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 80.0f, result.target);
+}
+
+void test_retracting_is_extrapolated() {
+    saved.state = AWNING_RETRACTING;
+    saved.target = 0.0f;
+    WarmRecovery result = recoverWarmState(saved, 1000, TRAVEL_TIME_MS);
+
+    TEST_ASSERT_EQUAL(AWNING_RETRACTING, result.state);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 35.0f, result.position);
+}
+
+void test_movement_reaching_end_stop_is_idle() {
+    saved.state = AWNING_RETRACTING;
+    saved.target = 0.0f;
+    WarmRecovery result = recoverWarmState(saved, 30000, TRAVEL_TIME_MS);
+
+    TEST_ASSERT_EQUAL(AWNING_IDLE, result.state);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, result.position);
+}
+
+void test_passed_target_runs_on_to_end_stop() {
+    saved.state = AWNING_EXTENDING;
+    saved.target = 45.0f;
+    WarmRecovery result = recoverWarmState(saved, 2000, TRAVEL_TIME_MS);
+
+    TEST_ASSERT_EQUAL(AWNING_EXTENDING, result.state);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 50.0f, result.position);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 100.0f, result.target);
+}
+
+void test_unknown_elapsed_assumes_end_stop() {
+    saved.state = AWNING_EXTENDING;
+    saved.target = 60.0f;
+    WarmRecovery result = recoverWarmState(saved, WARM_STATE_ELAPSED_UNKNOWN, TRAVEL_TIME_MS);
+
+    TEST_ASSERT_EQUAL(AWNING_IDLE, result.state);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 100.0f, result.position);
+}
+
+void test_out_of_range_position_is_clamped() {
+    saved.position = 140.0f;
+    WarmRecovery result = recoverWarmState(saved, 0, TRAVEL_TIME_MS);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 100.0f, result.position);
+}
+
+// =============================================================================
+// Test Runner
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Idle
+    RUN_TEST(test_idle_position_is_restored);
+    RUN_TEST(test_idle_position_does_not_need_the_clock);
+
+    // Movement
+    RUN_TEST(test_extending_is_extrapolated_and_resumed);
+    RUN_TEST(test_retracting_is_extrapolated);
+    RUN_TEST(test_movement_reaching_end_stop_is_idle);
+    RUN_TEST(test_passed_target_runs_on_to_end_stop);
+    RUN_TEST(test_unknown_elapsed_assumes_end_stop);
+    RUN_TEST(test_out_of_range_position_is_clamped);
+
+    return UNITY_END();
+}
@@ -0,0 +1,140 @@
+#include <unity.h>
+#include <string>
+#include "wifi_scan_cache.h"
+#include "html_template.h"
+
+typedef WifiScanCache<3> TestCache;
+
+static TestCache* cache;
+
+void setUp() {
+    cache = new TestCache();
+}
+
+void tearDown() {
+    delete cache;
+}
+
+static std::string toJson() {
+    std::string output;
+    auto sink = [&output](const char* data, size_t length) { output.append(data, length); };
+    HtmlTemplateWriter<8> writer;
+    cache->writeJson(writer, sink);
+    writer.flush(sink);
+    return output;
+}
+
+// =============================================================================
+// Collection Tests
+// =============================================================================
+
+void test_networks_are_sorted_strongest_first() {
+    cache->add("Garden", -80);
+    cache->add("Home", -45);
+    cache->add("Neighbour", -70);
+
+    TEST_ASSERT_EQUAL(3, cache->size());
+    TEST_ASSERT_EQUAL_STRING("Home", cache->get(0).ssid);
+    TEST_ASSERT_EQUAL_STRING("Neighbour", cache->get(1).ssid);
+    TEST_ASSERT_EQUAL_STRING("Garden", cache->get(2).ssid);
+}
+
+void test_duplicate_ssid_keeps_strongest() {
+    cache->add("Home", -70);
+    cache->add("Home", -50);
+    cache->add("Home", -90);
+
+    TEST_ASSERT_EQUAL(1, cache->size());
+    TEST_ASSERT_EQUAL(-50, cache->get(0).rssi);
+}
+
+void test_weakest_are_dropped_when_full() {
+    cache->add("A", -60);
+    cache->add("B", -70);
+    cache->add("C", -80);
+    cache->add("D", -50);
+    cache->add("E", -90);
+
+    TEST_ASSERT_EQUAL(3, cache->size());
+    TEST_ASSERT_EQUAL_STRING("D", cache->get(0).ssid);
+    TEST_ASSERT_EQUAL_STRING("B", cache->get(2).ssid);
+}
+
+void test_hidden_networks_are_skipped() {
+    cache->add("", -40);
+
+    TEST_ASSERT_EQUAL(0, cache->size());
+}
+
+// =============================================================================
+// Freshness Tests
+// =============================================================================
+
+void test_empty_cache_is_not_fresh() {
+    TEST_ASSERT_FALSE(cache->isFresh(0, 30000));
+}
+
+void test_cache_expires_after_ttl() {
+    cache->add("Home", -50);
+    cache->complete(1000);
+
+    TEST_ASSERT_TRUE(cache->isFresh(30999, 30000));
+    TEST_ASSERT_FALSE(cache->isFresh(31000, 30000));
+}
+
+void test_clear_invalidates() {
+    cache->add("Home", -50);
+    cache->complete(1000);
+    cache->clear();
+
+    TEST_ASSERT_FALSE(cache->isFresh(1000, 30000));
+    TEST_ASSERT_EQUAL(0, cache->size());
+}
+
+// =============================================================================
+// JSON Tests
+// =============================================================================
+
+void test_json_lists_networks() {
+    cache->add("Home", -45);
+    cache->add("Garden", -80);
+
+    TEST_ASSERT_EQUAL_STRING("[{\"ssid\":\"Home\",\"rssi\":-45},{\"ssid\":\"Garden\",\"rssi\":-80}]",
+                             toJson().c_str());
+}
+
+void test_json_of_empty_cache() {
+    TEST_ASSERT_EQUAL_STRING("[]", toJson().c_str());
+}
+
+void test_json_escapes_ssid() {
+    cache->add("a\"b\\c\x01", -60);
+
+    TEST_ASSERT_EQUAL_STRING("[{\"ssid\":\"a\\\"b\\\\c\\u0001\",\"rssi\":-60}]", toJson().c_str());
+}
+
+// =============================================================================
+// Test Runner
+// =============================================================================
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // Collection
+    RUN_TEST(test_networks_are_sorted_strongest_first);
+    RUN_TEST(test_duplicate_ssid_keeps_strongest);
+    RUN_TEST(test_weakest_are_dropped_when_full);
+    RUN_TEST(test_hidden_networks_are_skipped);
+
+    // Freshness
+    RUN_TEST(test_empty_cache_is_not_fresh);
+    RUN_TEST(test_cache_expires_after_ttl);
+    RUN_TEST(test_clear_invalidates);
+
+    // JSON
+    RUN_TEST(test_json_lists_networks);
+    RUN_TEST(test_json_of_empty_cache);
+    RUN_TEST(test_json_escapes_ssid);
+
+    return UNITY_END();
+}